@@ -28,10 +28,60 @@ uint16_t FX29_read(i2c_inst_t *i2c, uint8_t sladdr){
     return data; 
 }
 
-float compute_force(uint16_t force_data) {
-    float force;
-    float N_perbit = 0.00794f;
+// Queue a data fetch; collect it with FX29_fetch() on a later tick. The RP2040 I2C block cannot send an address-only
+// measurement request, so (as in FX29_read) only the data bytes are fetched and the status bits tell whether the
+// sensor finished a new measurement since the last fetch. The read must reach the bus within deadline_us (0: background).
+// Returns false if the previous read has not completed yet.
+bool FX29_request(fx29_async_t *s, uint8_t sladdr, uint32_t deadline_us){
+    if (i2c_txn_busy(&s->txn)) {
+        return false;
+    }
+    i2c_txn_setup(&s->txn, sladdr, NULL, 0, s->buffer, s->read_temp ? 4 : 2, NULL, NULL);
+    s->txn.deadline_us = deadline_us;
+    s->pending = i2c_dma_submit(&s->txn);
+    return s->pending;
+}
+
+// Returns true once per completed read started by FX29_request(). sample->status says whether the data is new;
+// stale and faulty fetches are returned too so the caller can decide to drop or flag them.
+bool FX29_fetch(fx29_async_t *s, fx29_sample_t *sample){
+    if (!s->pending || i2c_txn_busy(&s->txn)) {
+        return false;
+    }
+    s->pending = false;
+    if (s->txn.status != I2C_TXN_DONE) {
+        return false;
+    }
 
-    force = ((force_data - 1000.0f) * N_perbit);
-    return force;
+    sample->status = s->buffer[0] >> 6;
+    sample->bridge = ((s->buffer[0] & 0x3F) << 8) | s->buffer[1];
+    sample->time_us = s->txn.end_us;
+    sample->temperature = 0.0f;
+    if (s->read_temp) {
+        // 11-bit temperature spanning -50 to 150 C.
+        uint16_t raw_temp = (s->buffer[2] << 3) | (s->buffer[3] >> 5);
+        sample->temperature = raw_temp * (200.0f / 2047.0f) - 50.0f;
+    }
+
+    switch (sample->status) {
+        case FX29_STATUS_VALID: s->fresh++; break;
+        case FX29_STATUS_STALE: s->stale++; break;
+        default: s->faults++; break;
+    }
+    return true;
+}
+
+// Returns true once per new measurement fetched by FX29_request(), with the 14-bit data. Stale and faulty fetches
+// are dropped.
+bool FX29_poll(fx29_async_t *s, uint16_t *data){
+    fx29_sample_t sample;
+    if (!FX29_fetch(s, &sample) || sample.status != FX29_STATUS_VALID) {
+        return false;
+    }
+    *data = sample.bridge;
+    return true;
+}
+
+float compute_force(uint16_t force_data) {
+    return ((int32_t)force_data - FX29_ZERO_COUNTS) * (float)FX29_N_PER_COUNT;
 }
\ No newline at end of file
@@ -2,13 +2,46 @@
 #include <stdio.h>
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
+#include "../I2C_DMA/i2c_dma.h"
+#include "fx29_units.h"
 
 #ifdef __cplusplus
 extern "C" {
 #endif
 
+// Status bits (two MSBs of the first data byte).
+#define FX29_STATUS_VALID   0   // New bridge data since the last fetch.
+#define FX29_STATUS_CMD     1   // Sensor is in command mode.
+#define FX29_STATUS_STALE   2   // Data was already fetched; no measurement has completed since.
+#define FX29_STATUS_DIAG    3   // Diagnostic fault, data is not usable.
+
 uint16_t FX29_read(i2c_inst_t *i2c, uint8_t sladdr);
 
+// One data fetch, decoded.
+typedef struct {
+    uint16_t bridge;        // 14-bit bridge data.
+    float temperature;      // Degrees C, only when read_temp is set.
+    uint8_t status;         // FX29_STATUS_*.
+    uint32_t time_us;       // time_us_32() when the fetch completed.
+} fx29_sample_t;
+
+// State of a non-blocking read through the I2C DMA engine.
+typedef struct {
+    i2c_txn_t txn;
+    uint8_t buffer[4];
+    bool pending;
+    bool read_temp;         // Also fetch the two temperature bytes.
+    uint32_t fresh;         // Fetches with new data.
+    uint32_t stale;         // Fetches that returned data already seen.
+    uint32_t faults;        // Fetches in command or diagnostic state.
+} fx29_async_t;
+
+bool FX29_request(fx29_async_t *s, uint8_t sladdr, uint32_t deadline_us);
+
+bool FX29_fetch(fx29_async_t *s, fx29_sample_t *sample);
+
+bool FX29_poll(fx29_async_t *s, uint16_t *data);
+
 float compute_force(uint16_t force_data);
 
 #ifdef __cplusplus
@@ -0,0 +1,6 @@
+#pragma once
+
+// Bridge data to force: (bridge - FX29_ZERO_COUNTS) * FX29_N_PER_COUNT.
+// Kept apart from fx29.h, which needs the SDK, so host tools use the same calibration.
+#define FX29_ZERO_COUNTS    1000        // Bridge data at zero load.
+#define FX29_N_PER_COUNT    0.00794     // Newtons per count.
@@ -0,0 +1,363 @@
+/**
+ * @file i2c_dma.c
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the DMA driven I2C transaction engine.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "i2c_dma.h"
+
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+#include "pico/time.h"
+
+#include <string.h>
+
+static i2c_inst_t *bus;
+static uint sda, scl;
+static int tx_chan, rx_chan;
+static spin_lock_t *lock;
+
+static i2c_txn_t *head;                 ///< Waiting transactions, in submission order.
+static i2c_txn_t *active;               ///< Transaction on the bus, or NULL.
+static bool aborted;                    ///< The active transaction saw a TX abort.
+static bool recovering;                 ///< bus_recover() runs outside the lock; the bus stays reserved.
+static alarm_id_t timeout_alarm;
+static uint16_t cmds[I2C_DMA_MAX_LEN];  ///< IC_DATA_CMD words of the active transaction.
+static i2c_dma_stats_t stats;
+static i2c_dma_device_stats_t devices[I2C_DMA_MAX_DEVICES];
+static uint32_t window_start_us;
+
+/**
+ * @brief Statistics entry of a slave address, allocated on first use. NULL if the table is full.
+ *
+ */
+static i2c_dma_device_stats_t *device_entry(uint8_t addr) {
+    for (int i = 0; i < I2C_DMA_MAX_DEVICES; i++) {
+        if (devices[i].addr == addr) {
+            return &devices[i];
+        }
+        if (devices[i].addr == 0) {
+            devices[i].addr = addr;
+            return &devices[i];
+        }
+    }
+    return NULL;
+}
+
+static void start_next(void);
+
+/**
+ * @brief Frees the bus after a stuck transfer: clocks SCL until SDA is released, then generates a STOP.
+ * @details Runs with the controller disabled and the pins temporarily driven as open drain GPIOs. Takes up to ~110 us,
+ * so it is called without the lock, with interrupts enabled.
+ */
+static void bus_recover(void) {
+    bus->hw->enable = 0;
+
+    gpio_set_function(sda, GPIO_FUNC_SIO);
+    gpio_set_function(scl, GPIO_FUNC_SIO);
+    gpio_put(sda, 0);
+    gpio_put(scl, 0);
+    gpio_set_dir(sda, GPIO_IN);
+    gpio_set_dir(scl, GPIO_IN);
+    busy_wait_us_32(5);
+
+    // A slave in the middle of a read releases SDA after at most 9 clocks.
+    for (int i = 0; i < 9 && !gpio_get(sda); i++) {
+        gpio_set_dir(scl, GPIO_OUT);
+        busy_wait_us_32(5);
+        gpio_set_dir(scl, GPIO_IN);
+        busy_wait_us_32(5);
+    }
+
+    // STOP: SDA rises while SCL is high.
+    gpio_set_dir(sda, GPIO_OUT);
+    busy_wait_us_32(5);
+    gpio_set_dir(sda, GPIO_IN);
+    busy_wait_us_32(5);
+
+    gpio_set_function(sda, GPIO_FUNC_I2C);
+    gpio_set_function(scl, GPIO_FUNC_I2C);
+    (void)bus->hw->clr_intr;
+}
+
+/**
+ * @brief Ends the active transaction, starts the next one, and runs the callback outside the lock.
+ * @details Must be called with the lock held; returns with it released.
+ */
+static void finish(i2c_txn_status_t status, uint32_t save) {
+    i2c_txn_t *txn = active;
+    active = NULL;
+
+    if (timeout_alarm > 0) {
+        cancel_alarm(timeout_alarm);
+        timeout_alarm = 0;
+    }
+    dma_channel_abort(tx_chan);
+    dma_channel_abort(rx_chan);
+
+    bus->hw->intr_mask = 0;
+    txn->end_us = time_us_32();
+    uint32_t busy = txn->end_us - txn->start_us;
+    stats.busy_us += busy;
+
+    i2c_dma_device_stats_t *dev = device_entry(txn->addr);
+    if (dev) {
+        dev->txns++;
+        dev->bytes += txn->tx_len + txn->data_len + txn->rx_len;
+        dev->busy_us += busy;
+        if (busy > dev->max_busy_us) {
+            dev->max_busy_us = busy;
+        }
+    }
+
+    switch (status) {
+        case I2C_TXN_DONE:    stats.completed++; break;
+        case I2C_TXN_NACK:    stats.nacks++; break;
+        case I2C_TXN_TIMEOUT: stats.timeouts++; break;
+        default: break;
+    }
+    txn->status = status;
+
+    start_next();
+    spin_unlock(lock, save);
+
+    if (txn->cb) {
+        txn->cb(txn);
+    }
+}
+
+static int64_t timeout_cb(alarm_id_t id, void *user_data) {
+    uint32_t save = spin_lock_blocking(lock);
+    if (active == user_data && timeout_alarm == id && !recovering) {
+        // Keep the transaction active so nothing else is started, but stop the transfer and its interrupts.
+        timeout_alarm = 0;
+        recovering = true;
+        bus->hw->intr_mask = 0;
+        dma_channel_abort(tx_chan);
+        dma_channel_abort(rx_chan);
+        spin_unlock(lock, save);
+
+        bus_recover();
+
+        save = spin_lock_blocking(lock);
+        recovering = false;
+        stats.recoveries++;
+        finish(I2C_TXN_TIMEOUT, save);
+    } else {
+        spin_unlock(lock, save);
+    }
+    return 0;
+}
+
+static void i2c_dma_irq(void) {
+    uint32_t save = spin_lock_blocking(lock);
+    if (recovering) {
+        // Raised before the mask was cleared; the timeout path finishes the transaction.
+        (void)bus->hw->clr_intr;
+        spin_unlock(lock, save);
+        return;
+    }
+    uint32_t stat = bus->hw->intr_stat;
+
+    if (stat & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+        // The controller flushes the TX FIFO and sends a STOP. Completion is reported on STOP_DET.
+        (void)bus->hw->clr_tx_abrt;
+        dma_channel_abort(tx_chan);
+        aborted = true;
+    }
+
+    if ((stat & I2C_IC_INTR_STAT_R_STOP_DET_BITS) && active) {
+        (void)bus->hw->clr_stop_det;
+        if (!aborted) {
+            // The last bytes are already in the RX FIFO; the DMA drains them within a few cycles.
+            while (dma_channel_is_busy(rx_chan)) {
+                tight_loop_contents();
+            }
+        }
+        finish(aborted ? I2C_TXN_NACK : I2C_TXN_DONE, save);
+        return;
+    }
+
+    (void)bus->hw->clr_stop_det;
+    spin_unlock(lock, save);
+}
+
+/**
+ * @brief Puts the waiting transaction with the earliest deadline on the bus. Called with the lock held.
+ * @details The queue only ever holds a handful of transactions, so a linear scan is cheaper than keeping it sorted.
+ * Ties go to the earlier submission, which keeps the chunks of a display frame in order.
+ */
+static void start_next(void) {
+    if (active || !head) {
+        return;
+    }
+    i2c_txn_t **best = &head;
+    for (i2c_txn_t **it = &head->next; *it; it = &(*it)->next) {
+        if ((int32_t)((*it)->due_us - (*best)->due_us) < 0) {
+            best = it;
+        }
+    }
+    i2c_txn_t *txn = *best;
+    *best = txn->next;
+
+    // Expand the transfer into command words. The first read restarts after a write; the last word carries the STOP.
+    uint32_t n = 0;
+    for (uint32_t i = 0; i < txn->tx_len; i++) {
+        cmds[n++] = txn->tx[i];
+    }
+    for (uint32_t i = 0; i < txn->data_len; i++) {
+        cmds[n++] = txn->data[i];
+    }
+    uint32_t writes = n;
+    for (uint32_t i = 0; i < txn->rx_len; i++) {
+        cmds[n++] = I2C_IC_DATA_CMD_CMD_BITS | ((i == 0 && writes) ? I2C_IC_DATA_CMD_RESTART_BITS : 0);
+    }
+    cmds[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    active = txn;
+    aborted = false;
+    txn->status = I2C_TXN_ACTIVE;
+    txn->start_us = time_us_32();
+
+    i2c_dma_device_stats_t *dev = device_entry(txn->addr);
+    if (dev) {
+        uint32_t wait = txn->start_us - txn->queued_us;
+        if (wait > dev->max_wait_us) {
+            dev->max_wait_us = wait;
+        }
+        if ((int32_t)(txn->start_us - txn->due_us) > 0) {
+            dev->late++;
+        }
+    }
+
+    bus->hw->enable = 0;
+    bus->hw->tar = txn->addr;
+    bus->hw->enable = 1;
+
+    (void)bus->hw->clr_intr;
+    bus->hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+
+    if (txn->rx_len) {
+        dma_channel_transfer_to_buffer_now(rx_chan, txn->rx, txn->rx_len);
+    }
+    dma_channel_transfer_from_buffer_now(tx_chan, cmds, n);
+
+    uint32_t timeout = txn->timeout_us;
+    if (timeout == 0) {
+        timeout = I2C_DMA_MIN_TIMEOUT + 2 * I2C_DMA_BYTE_US * (n + 1);
+    }
+    timeout_alarm = add_alarm_in_us(timeout, timeout_cb, txn, true);
+}
+
+void i2c_dma_init(i2c_inst_t *i2c, uint sda_pin, uint scl_pin) {
+    bus = i2c;
+    sda = sda_pin;
+    scl = scl_pin;
+    lock = spin_lock_instance(spin_lock_claim_unused(true));
+    window_start_us = time_us_32();
+
+    tx_chan = dma_claim_unused_channel(true);
+    dma_channel_config c = dma_channel_get_default_config(tx_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(i2c, true));
+    dma_channel_configure(tx_chan, &c, &i2c->hw->data_cmd, cmds, 0, false);
+
+    rx_chan = dma_claim_unused_channel(true);
+    c = dma_channel_get_default_config(rx_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_dreq(&c, i2c_get_dreq(i2c, false));
+    dma_channel_configure(rx_chan, &c, NULL, &i2c->hw->data_cmd, 0, false);
+
+    // Interrupts are only unmasked while a transaction is active, so blocking SDK calls keep their abort status.
+    i2c->hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS | I2C_IC_DMA_CR_RDMAE_BITS;
+    i2c->hw->intr_mask = 0;
+
+    uint irq = I2C0_IRQ + i2c_get_index(i2c);
+    irq_set_exclusive_handler(irq, i2c_dma_irq);
+    irq_set_enabled(irq, true);
+}
+
+void i2c_txn_setup(i2c_txn_t *txn, uint8_t addr, const uint8_t *tx, uint16_t tx_len, uint8_t *rx, uint16_t rx_len,
+                   i2c_txn_cb_t cb, void *ctx) {
+    txn->addr = addr;
+    txn->tx = tx;
+    txn->tx_len = tx_len;
+    txn->data = NULL;
+    txn->data_len = 0;
+    txn->rx = rx;
+    txn->rx_len = rx_len;
+    txn->deadline_us = 0;
+    txn->timeout_us = 0;
+    txn->cb = cb;
+    txn->ctx = ctx;
+    txn->status = I2C_TXN_IDLE;
+    txn->next = NULL;
+}
+
+bool i2c_dma_submit(i2c_txn_t *txn) {
+    uint32_t len = (uint32_t)txn->tx_len + txn->data_len + txn->rx_len;
+    uint32_t save = spin_lock_blocking(lock);
+    if (i2c_txn_busy(txn) || len == 0 || len > I2C_DMA_MAX_LEN) {
+        stats.rejected++;
+        spin_unlock(lock, save);
+        return false;
+    }
+
+    txn->status = I2C_TXN_QUEUED;
+    txn->queued_us = time_us_32();
+    txn->due_us = txn->queued_us + (txn->deadline_us ? txn->deadline_us : I2C_DMA_BACKGROUND);
+    txn->next = NULL;
+    i2c_txn_t **it = &head;
+    while (*it) {
+        it = &(*it)->next;
+    }
+    *it = txn;
+
+    start_next();
+    spin_unlock(lock, save);
+    return true;
+}
+
+i2c_txn_status_t i2c_dma_wait(i2c_txn_t *txn) {
+    while (i2c_txn_busy(txn)) {
+        tight_loop_contents();
+    }
+    return txn->status;
+}
+
+i2c_dma_stats_t i2c_dma_stats(void) {
+    uint32_t save = spin_lock_blocking(lock);
+    i2c_dma_stats_t s = stats;
+    spin_unlock(lock, save);
+    return s;
+}
+
+uint32_t i2c_dma_device_stats(i2c_dma_device_stats_t *out) {
+    uint32_t save = spin_lock_blocking(lock);
+    memcpy(out, devices, sizeof(devices));
+    uint32_t window = time_us_32() - window_start_us;
+    spin_unlock(lock, save);
+    return window;
+}
+
+void i2c_dma_reset_stats(void) {
+    uint32_t save = spin_lock_blocking(lock);
+    for (int i = 0; i < I2C_DMA_MAX_DEVICES; i++) {
+        uint8_t addr = devices[i].addr;
+        memset(&devices[i], 0, sizeof(devices[i]));
+        devices[i].addr = addr;
+    }
+    window_start_us = time_us_32();
+    spin_unlock(lock, save);
+}
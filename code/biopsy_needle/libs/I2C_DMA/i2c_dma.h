@@ -0,0 +1,173 @@
+/**
+ * @file i2c_dma.h
+ * @author Thomas Chang
+ * @brief Non-blocking, DMA driven I2C transaction engine for the shared sensor/display bus.
+ * @details Callers describe a transfer as an i2c_txn_t (a write, a read, or a write followed by a repeated-start read)
+ * and submit it. Transactions are queued and run one at a time, earliest deadline first, so a sensor read submitted
+ * while a display frame is being sent goes out before the next chunk of the frame. The engine expands each one into IC_DATA_CMD command
+ * words, one DMA channel feeds them to the controller and a second DMA channel collects read bytes. Completion (STOP
+ * detected) and NACKs (TX abort) are taken from the I2C interrupt, so the submitting code only pays for queueing and
+ * setup, never for bus time.
+ *
+ * Every transaction has a timeout. If it expires the transfer is aborted and the bus is recovered by clocking SCL until
+ * a slave holding SDA low lets go, so a stuck device can no longer hang the needle.
+ *
+ * Per-device counters (bus time, queueing delay, missed deadlines) show how the bus is shared.
+ *
+ * The transaction memory belongs to the caller and must stay valid until the transaction completes. Callbacks run in
+ * interrupt context on the core that called i2c_dma_init() and may submit further transactions.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "pico/stdlib.h"
+#include "hardware/i2c.h"
+
+#define I2C_DMA_MAX_LEN     1040    ///< Largest tx_len + rx_len of one transaction (one full 128x64 OLED frame fits).
+#define I2C_DMA_BYTE_US     25      ///< Bus time of one byte at 400 kHz (9 clocks) rounded up. Used for default timeouts.
+#define I2C_DMA_MIN_TIMEOUT 1000    ///< Floor of the default timeout in microseconds.
+#define I2C_DMA_BACKGROUND  100000  ///< Relative deadline in microseconds of transactions that do not set one.
+#define I2C_DMA_MAX_DEVICES 4       ///< Slave addresses tracked by the per-device statistics.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Life cycle of a transaction.
+ *
+ */
+typedef enum {
+    I2C_TXN_IDLE = 0,   ///< Never submitted.
+    I2C_TXN_QUEUED,     ///< Waiting for the bus.
+    I2C_TXN_ACTIVE,     ///< On the bus.
+    I2C_TXN_DONE,       ///< Finished successfully. Read data is valid.
+    I2C_TXN_NACK,       ///< The slave did not acknowledge its address or a data byte.
+    I2C_TXN_TIMEOUT     ///< Did not finish within timeout_us. The bus was recovered.
+} i2c_txn_status_t;
+
+typedef struct i2c_txn i2c_txn_t;
+
+/// Completion callback. Runs in interrupt context.
+typedef void (*i2c_txn_cb_t)(i2c_txn_t *txn);
+
+/**
+ * @brief One I2C transfer. Writes tx then data, then reads rx_len bytes after a repeated start.
+ * @details data lets a control or register byte be sent in front of a payload that lives elsewhere, e.g. one page of
+ * a frame buffer, without copying it.
+ */
+struct i2c_txn {
+    uint8_t addr;               ///< 7 bit slave address.
+    const uint8_t *tx;          ///< Bytes to write.
+    uint16_t tx_len;
+    const uint8_t *data;        ///< Bytes to write after tx. NULL if unused.
+    uint16_t data_len;
+    uint8_t *rx;                ///< Destination of read bytes.
+    uint16_t rx_len;
+    uint32_t deadline_us;       ///< Must be on the bus within this many microseconds of submission. 0 for background.
+    uint32_t timeout_us;        ///< 0 selects a default from the transfer length.
+    i2c_txn_cb_t cb;            ///< Called on completion, may be NULL.
+    void *ctx;                  ///< Free for the owner of the transaction.
+    volatile i2c_txn_status_t status;
+    uint32_t queued_us;         ///< Time the transfer was submitted.
+    uint32_t due_us;            ///< Absolute deadline used to order the queue.
+    uint32_t start_us;          ///< Time the transfer was put on the bus.
+    uint32_t end_us;            ///< Time the transfer completed.
+    i2c_txn_t *next;            ///< Queue link. Owned by the engine.
+};
+
+/**
+ * @brief Counters of the engine since start up.
+ *
+ */
+typedef struct {
+    uint32_t completed;         ///< Transactions finished successfully.
+    uint32_t nacks;             ///< Transactions ended by a NACK.
+    uint32_t timeouts;          ///< Transactions ended by a timeout.
+    uint32_t recoveries;        ///< Bus recoveries performed.
+    uint32_t rejected;          ///< Submissions refused (already pending, empty or too long).
+    uint32_t busy_us;           ///< Total time the bus was busy with transactions.
+} i2c_dma_stats_t;
+
+/**
+ * @brief Bus usage of one slave address since the last i2c_dma_reset_stats().
+ *
+ */
+typedef struct {
+    uint8_t addr;               ///< Slave address, 0 if the entry is unused.
+    uint32_t txns;              ///< Transactions completed in any way.
+    uint32_t bytes;             ///< Bytes moved, excluding addresses.
+    uint32_t busy_us;           ///< Bus time.
+    uint32_t max_busy_us;       ///< Longest single transaction.
+    uint32_t max_wait_us;       ///< Longest time from submission to the bus.
+    uint32_t late;              ///< Transactions that started after their deadline.
+} i2c_dma_device_stats_t;
+
+/**
+ * @brief Takes over an I2C instance that was set up with i2c_init(). Claims two DMA channels and the I2C interrupt.
+ * @details Blocking SDK calls on the same instance remain usable while the engine is idle, e.g. for device setup.
+ * The interrupt is taken on the calling core.
+ * @param i2c I2C instance.
+ * @param sda_pin SDA pin, needed for bus recovery.
+ * @param scl_pin SCL pin, needed for bus recovery.
+ */
+void i2c_dma_init(i2c_inst_t *i2c, uint sda_pin, uint scl_pin);
+
+/**
+ * @brief Fills in a transaction with no data segment and a background deadline. Does not submit it.
+ *
+ */
+void i2c_txn_setup(i2c_txn_t *txn, uint8_t addr, const uint8_t *tx, uint16_t tx_len, uint8_t *rx, uint16_t rx_len,
+                   i2c_txn_cb_t cb, void *ctx);
+
+/**
+ * @brief Queues a transaction. Safe from either core and from callbacks.
+ *
+ * @param txn The transaction. Must not be queued or active already.
+ * @return false if the transaction was refused.
+ */
+bool i2c_dma_submit(i2c_txn_t *txn);
+
+/**
+ * @brief Whether a transaction is still queued or on the bus.
+ *
+ */
+static inline bool i2c_txn_busy(const i2c_txn_t *txn) {
+    return txn->status == I2C_TXN_QUEUED || txn->status == I2C_TXN_ACTIVE;
+}
+
+/**
+ * @brief Blocks until a transaction completes. For start up code only; never call from a callback.
+ *
+ * @return i2c_txn_status_t Final status.
+ */
+i2c_txn_status_t i2c_dma_wait(i2c_txn_t *txn);
+
+/**
+ * @brief Snapshot of the engine counters.
+ *
+ */
+i2c_dma_stats_t i2c_dma_stats(void);
+
+/**
+ * @brief Copies the per-device statistics.
+ *
+ * @param out Array of I2C_DMA_MAX_DEVICES entries. Unused entries have addr 0.
+ * @return uint32_t Microseconds covered by the statistics, for turning busy_us into a utilization.
+ */
+uint32_t i2c_dma_device_stats(i2c_dma_device_stats_t *out);
+
+/**
+ * @brief Clears the per-device statistics and starts a new measurement window.
+ *
+ */
+void i2c_dma_reset_stats(void);
+
+#ifdef __cplusplus
+}
+#endif
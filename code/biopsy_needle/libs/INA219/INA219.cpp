@@ -12,6 +12,7 @@ void INA219::I2C_START(uint32_t sda_pin, uint32_t scl_pin, uint32_t speed_khz) {
 
 uint16_t INA219::read_register(uint8_t reg) {
     uint8_t buf[2];
+    _reg_ptr = reg;
     i2c_write_blocking(_i2c_instance, _i2c_addr, &reg, 1, true);
     i2c_read_blocking(_i2c_instance, _i2c_addr, buf, 2, false);
 
@@ -23,17 +24,39 @@ void INA219::write_register(uint8_t reg, uint16_t value) {
     buf[0] = reg;
     buf[1] = (value >> 8) & 0xFF;
     buf[2] = value & 0xFF;
+    _reg_ptr = reg;
     i2c_write_blocking(_i2c_instance, _i2c_addr, buf, 3, false);
 }
 
 void INA219::init() {
-    uint16_t config = 0x399F;
-    write_register(INA219_REG_CONFIG, config);
+    configure(BRNG_32V, PGA_320MV, ADC_12BIT, ADC_12BIT, MODE_BOTH_CONTINUOUS);
+}
+
+// Writes the configuration register: bus range, shunt gain, bus/shunt ADC resolution or averaging, operating mode.
+void INA219::configure(uint8_t brng, uint8_t pga, uint8_t badc, uint8_t sadc, uint8_t mode) {
+    _config = ((brng & 0x1) << 13) | ((pga & 0x3) << 11) | ((badc & 0xF) << 7) | ((sadc & 0xF) << 3) | (mode & 0x7);
+    write_register(INA219_REG_CONFIG, _config);
     sleep_ms(10);
 }
 
+// Time of one conversion cycle in the configured mode (datasheet table 5), i.e. how often CNVR sets.
+uint32_t INA219::conversion_us() const {
+    static const uint16_t adc_us[16] = {84, 148, 276, 532, 84, 148, 276, 532,
+                                        532, 1060, 2130, 4260, 8510, 17020, 34050, 68100};
+    uint8_t mode = _config & 0x7;
+    uint32_t us = 0;
+    if (mode == MODE_SHUNT_TRIGGERED || mode == MODE_SHUNT_CONTINUOUS || mode == MODE_BOTH_TRIGGERED || mode == MODE_BOTH_CONTINUOUS) {
+        us += adc_us[(_config >> 3) & 0xF];
+    }
+    if (mode == MODE_BUS_TRIGGERED || mode == MODE_BUS_CONTINUOUS || mode == MODE_BOTH_TRIGGERED || mode == MODE_BOTH_CONTINUOUS) {
+        us += adc_us[(_config >> 7) & 0xF];
+    }
+    return us;
+}
+
 void INA219::calibrate(float shunt_resistor_value, float max_expected_amps) {
     _current_LSB = max_expected_amps / 32768.0;
+    _shunt_ohms = shunt_resistor_value;
     uint16_t cal_reg_value = (uint16_t)(0.04096 / (_current_LSB * shunt_resistor_value));
     write_register(INA219_REG_CALIBRATION, cal_reg_value);
 }
@@ -57,6 +80,91 @@ float INA219::read_power() {
     uint16_t value = read_register(INA219_REG_POWER);
     return value * 0.02;
 }
+
+// Reads one register through the DMA engine. The pointer byte is left out when the chip already points at reg.
+bool INA219::submit_read(uint8_t reg) {
+    _txn_reg = reg;
+    i2c_txn_setup(&_txn, _i2c_addr, &_txn_reg, _reg_ptr == reg ? 0 : 1, _rx, 2, sample_cb, this);
+    _txn.deadline_us = _deadline_us;
+    if (!i2c_dma_submit(&_txn)) {
+        _reg_ptr = INA219_REG_NONE;
+        return false;
+    }
+    _reg_ptr = reg;
+    return true;
+}
+
+void INA219::sample_cb(i2c_txn_t *txn) {
+    static_cast<INA219 *>(txn->ctx)->sample_step();
+}
+
+// Runs in the I2C interrupt after each read of the chain: bus voltage (CNVR check), current, then power. Reading the
+// power register clears CNVR, so every conversion is handed out exactly once.
+void INA219::sample_step() {
+    if (_txn.status != I2C_TXN_DONE) {
+        _reg_ptr = INA219_REG_NONE;
+        _chain = CHAIN_FAILED;
+        return;
+    }
+
+    uint16_t value = (_rx[0] << 8) | _rx[1];
+    bool next = false;
+    switch (_txn_reg) {
+        case INA219_REG_BUSVOLTAGE:
+            if (!(value & INA219_BUS_CNVR)) {
+                _chain = CHAIN_NOT_READY;
+                return;
+            }
+            _raw_bus = value;
+            _sample_us = _txn.end_us;
+            next = submit_read(INA219_REG_CURRENT);
+            break;
+        case INA219_REG_CURRENT:
+            _raw_current = value;
+            next = submit_read(INA219_REG_POWER);
+            break;
+        case INA219_REG_POWER:
+            _raw_power = value;
+            _chain = CHAIN_READY;
+            return;
+        default:
+            break;
+    }
+    if (!next) {
+        _chain = CHAIN_FAILED;
+    }
+}
+
+// Starts reading the next conversion, if there is one, within deadline_us (0: background). While the chip has no new
+// conversion only the bus voltage register is read, without rewriting the register pointer.
+// Returns false if the previous sample read has not completed yet.
+bool INA219::request_sample(uint32_t deadline_us) {
+    if (_chain == CHAIN_BUSY || i2c_txn_busy(&_txn)) {
+        return false;
+    }
+    _deadline_us = deadline_us;
+    _chain = CHAIN_BUSY;
+    if (!submit_read(INA219_REG_BUSVOLTAGE)) {
+        _chain = CHAIN_FAILED;
+        return false;
+    }
+    return true;
+}
+
+// Returns true once per conversion collected by request_sample().
+bool INA219::poll_sample(ina219_sample_t *sample) {
+    if (_chain != CHAIN_READY) {
+        return false;
+    }
+    _chain = CHAIN_IDLE;
+
+    sample->bus_raw = _raw_bus;
+    sample->current_raw = (int16_t)_raw_current;
+    sample->power_raw = _raw_power;
+    sample->overflow = (_raw_bus & INA219_BUS_OVF) != 0;
+    sample->time_us = _sample_us;
+    return true;
+}
 //
 // Created by elect on 3/17/2023.
 //
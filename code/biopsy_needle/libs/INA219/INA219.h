@@ -5,21 +5,77 @@
 #include "pico/stdlib.h"
 #include "hardware/i2c.h"
 #include "math.h"
+#include "../I2C_DMA/i2c_dma.h"
+
+/**
+ * One conversion of the INA219, read once by INA219::poll_sample(). The registers are kept raw so the caller chooses
+ * how to scale them: INA219::bus_V() and friends in float, or a fixed point map of current_LSB() in the sample path.
+ */
+typedef struct {
+    uint16_t bus_raw;       ///< Bus voltage register (voltage in bits 15-3, 4 mV per LSB).
+    int16_t current_raw;    ///< Current register, current_LSB() amps per LSB.
+    uint16_t power_raw;     ///< Power register, 20 * current_LSB() watts per LSB.
+    bool overflow;          ///< OVF: the current or power calculation overflowed.
+    uint32_t time_us;       ///< time_us_32() when the conversion ready flag was seen.
+} ina219_sample_t;
 
 class INA219 {
 public:
+    // Configuration register fields, see configure().
+    static constexpr uint8_t BRNG_16V = 0;
+    static constexpr uint8_t BRNG_32V = 1;
+    static constexpr uint8_t PGA_40MV = 0;
+    static constexpr uint8_t PGA_80MV = 1;
+    static constexpr uint8_t PGA_160MV = 2;
+    static constexpr uint8_t PGA_320MV = 3;
+    static constexpr uint8_t ADC_9BIT = 0x0;
+    static constexpr uint8_t ADC_10BIT = 0x1;
+    static constexpr uint8_t ADC_11BIT = 0x2;
+    static constexpr uint8_t ADC_12BIT = 0x3;
+    static constexpr uint8_t ADC_AVG2 = 0x9;
+    static constexpr uint8_t ADC_AVG4 = 0xA;
+    static constexpr uint8_t ADC_AVG8 = 0xB;
+    static constexpr uint8_t ADC_AVG16 = 0xC;
+    static constexpr uint8_t ADC_AVG32 = 0xD;
+    static constexpr uint8_t ADC_AVG64 = 0xE;
+    static constexpr uint8_t ADC_AVG128 = 0xF;
+    static constexpr uint8_t MODE_POWER_DOWN = 0;
+    static constexpr uint8_t MODE_SHUNT_TRIGGERED = 1;
+    static constexpr uint8_t MODE_BUS_TRIGGERED = 2;
+    static constexpr uint8_t MODE_BOTH_TRIGGERED = 3;
+    static constexpr uint8_t MODE_ADC_OFF = 4;
+    static constexpr uint8_t MODE_SHUNT_CONTINUOUS = 5;
+    static constexpr uint8_t MODE_BUS_CONTINUOUS = 6;
+    static constexpr uint8_t MODE_BOTH_CONTINUOUS = 7;
+
     INA219(i2c_inst_t *i2c_instance, uint8_t i2c_addr);
     void I2C_START(uint32_t sda_pin, uint32_t scl_pin, uint32_t speed_khz);
     void init();
+    void configure(uint8_t brng, uint8_t pga, uint8_t badc, uint8_t sadc, uint8_t mode);
+    uint32_t conversion_us() const;
     void calibrate(float shunt_resistor_value, float max_expected_amps);
     float read_voltage();
     float read_shunt_voltage();
     float read_current();
     float read_power();
 
+    // Non-blocking access through the I2C DMA engine. Start a read, then collect it on a later tick.
+    bool request_sample(uint32_t deadline_us = 0);
+    bool poll_sample(ina219_sample_t *sample);
+
+    // Scaling of a sample. Float; meant for display and diagnostics.
+    float current_LSB() const { return _current_LSB; }
+    float bus_V(const ina219_sample_t &s) const { return (s.bus_raw >> 3) * 0.004f; }
+    float current_A(const ina219_sample_t &s) const { return s.current_raw * _current_LSB; }
+    float shunt_mV(const ina219_sample_t &s) const { return current_A(s) * _shunt_ohms * 1000.0f; }
+    float power_W(const ina219_sample_t &s) const { return s.power_raw * 20.0f * _current_LSB; }
+
 private:
     uint16_t read_register(uint8_t reg);
     void write_register(uint8_t reg, uint16_t value);
+    bool submit_read(uint8_t reg);
+    void sample_step();
+    static void sample_cb(i2c_txn_t *txn);
 
     //static constexpr uint8_t INA219_I2C_ADDR = 0x40;
     static constexpr uint8_t INA219_REG_CONFIG = 0x00;
@@ -28,10 +84,30 @@ private:
     static constexpr uint8_t INA219_REG_POWER = 0x03;
     static constexpr uint8_t INA219_REG_CURRENT = 0x04;
     static constexpr uint8_t INA219_REG_CALIBRATION = 0x05;
+    static constexpr uint8_t INA219_REG_NONE = 0xFF;
+    static constexpr uint16_t INA219_BUS_CNVR = 0x0002;
+    static constexpr uint16_t INA219_BUS_OVF = 0x0001;
+
+    // Progress of the sample read chain, advanced from the I2C completion callback.
+    enum : uint8_t { CHAIN_IDLE, CHAIN_BUSY, CHAIN_READY, CHAIN_NOT_READY, CHAIN_FAILED };
 
     uint8_t _i2c_addr;
     i2c_inst_t *_i2c_instance;
     float _current_LSB;
+    float _shunt_ohms = 0.0f;
+    uint16_t _config = 0x399F;
+
+    i2c_txn_t _txn;
+    uint8_t _txn_reg;
+    uint8_t _rx[2];
+
+    uint8_t _reg_ptr = INA219_REG_NONE;    // Register the chip's pointer is known to be on.
+    uint32_t _deadline_us = 0;
+    volatile uint8_t _chain = CHAIN_IDLE;
+    uint16_t _raw_bus;
+    uint16_t _raw_current;
+    uint16_t _raw_power;
+    uint32_t _sample_us;
 };
 
 #endif // INA219_H
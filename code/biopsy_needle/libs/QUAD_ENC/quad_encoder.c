@@ -0,0 +1,173 @@
+/**
+ * @file quad_encoder.c
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the PIO quadrature decoder.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "quad_encoder.h"
+#include "quadrature_encoder.pio.h"
+#include "edge_period.pio.h"
+#include "limit_watch.pio.h"
+
+#include "hardware/clocks.h"
+#include "hardware/irq.h"
+
+static quad_encoder_t *limit_enc = NULL;    ///< Decoder whose limit the PIO interrupt belongs to.
+
+bool quad_encoder_init(quad_encoder_t *enc, PIO pio, uint pin_base) {
+    enc->pio = pio;
+    enc->zero = 0;
+    enc->timing_sm = -1;
+    quad_velocity_init(&enc->vel, 0.0f, 0, time_us_32());
+    enc->limit_sm = -1;
+
+    if (!pio_can_add_program_at_offset(pio, &quadrature_encoder_program, 0)) {
+        return false;
+    }
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0) {
+        return false;
+    }
+    enc->sm = (uint)sm;
+    pio_add_program_at_offset(pio, &quadrature_encoder_program, 0);
+
+    pio_sm_set_consecutive_pindirs(pio, enc->sm, pin_base, 2, false);
+    pio_gpio_init(pio, pin_base);
+    pio_gpio_init(pio, pin_base + 1);
+    gpio_pull_up(pin_base);
+    gpio_pull_up(pin_base + 1);
+
+    pio_sm_config c = quadrature_encoder_program_get_default_config(0);
+    sm_config_set_in_pins(&c, pin_base);
+    sm_config_set_in_shift(&c, false, false, 32);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_RX);
+    sm_config_set_clkdiv(&c, 1.0f);
+
+    pio_sm_init(pio, enc->sm, 0, &c);
+    pio_sm_set_enabled(pio, enc->sm, true);
+    return true;
+}
+
+bool quad_encoder_init_timing(quad_encoder_t *enc, PIO pio, uint pin, uint32_t zero_us) {
+    if (!pio_can_add_program(pio, &edge_period_program)) {
+        return false;
+    }
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0) {
+        return false;
+    }
+    uint offset = pio_add_program(pio, &edge_period_program);
+
+    pio_sm_config c = edge_period_program_get_default_config(offset);
+    sm_config_set_jmp_pin(&c, pin);
+    sm_config_set_fifo_join(&c, PIO_FIFO_JOIN_RX);
+    sm_config_set_clkdiv(&c, 1.0f);
+    pio_sm_init(pio, (uint)sm, offset, &c);
+
+    enc->timing_pio = pio;
+    enc->timing_sm = sm;
+    quad_velocity_init(&enc->vel, 2.0f / clock_get_hz(clk_sys), zero_us, time_us_32());
+    pio_sm_set_enabled(pio, (uint)sm, true);
+    return true;
+}
+
+static void __not_in_flash_func(limit_irq)(void) {
+    quad_encoder_t *enc = limit_enc;
+    pio_interrupt_clear(enc->limit_pio, (uint)enc->limit_sm);
+    enc->limit_cb();
+}
+
+bool quad_encoder_init_limit(quad_encoder_t *enc, PIO pio, uint pin, quad_encoder_limit_cb_t cb) {
+    if (limit_enc != NULL || !pio_can_add_program(pio, &limit_watch_program)) {
+        return false;
+    }
+    int sm = pio_claim_unused_sm(pio, false);
+    if (sm < 0) {
+        return false;
+    }
+    uint offset = pio_add_program(pio, &limit_watch_program);
+
+    pio_sm_config c = limit_watch_program_get_default_config(offset);
+    sm_config_set_in_pins(&c, pin);
+    sm_config_set_jmp_pin(&c, pin);
+    sm_config_set_clkdiv(&c, 1.0f);
+    pio_sm_init(pio, (uint)sm, offset, &c);
+
+    enc->limit_pio = pio;
+    enc->limit_sm = sm;
+    enc->limit_offset = offset;
+    enc->limit_cb = cb;
+    limit_enc = enc;
+
+    // The "irq 0 rel" of state machine n sets PIO flag n.
+    pio_interrupt_clear(pio, (uint)sm);
+    pio_set_irq0_source_enabled(pio, (pio_interrupt_source_t)(pis_interrupt0 + sm), true);
+    uint irq = (uint)pio_get_irq_num(pio, 0);
+    irq_set_exclusive_handler(irq, limit_irq);
+    irq_set_priority(irq, PICO_HIGHEST_IRQ_PRIORITY);
+    irq_set_enabled(irq, true);
+    return true;
+}
+
+void quad_encoder_disarm_limit(quad_encoder_t *enc) {
+    if (enc->limit_sm < 0) {
+        return;
+    }
+    pio_sm_set_enabled(enc->limit_pio, (uint)enc->limit_sm, false);
+    pio_interrupt_clear(enc->limit_pio, (uint)enc->limit_sm);
+}
+
+void quad_encoder_arm_limit(quad_encoder_t *enc, int32_t position, int32_t limit, bool increasing) {
+    if (enc->limit_sm < 0) {
+        return;
+    }
+    quad_encoder_disarm_limit(enc);
+    uint32_t edges = quad_limit_edges(position, limit, increasing);
+    if (edges == 0) {
+        enc->limit_cb();
+        return;
+    }
+
+    // Back to the pull with an empty FIFO, then hand over the distance.
+    PIO pio = enc->limit_pio;
+    uint sm = (uint)enc->limit_sm;
+    pio_sm_clear_fifos(pio, sm);
+    pio_sm_restart(pio, sm);
+    pio_sm_exec(pio, sm, pio_encode_jmp(enc->limit_offset));
+    pio_sm_put(pio, sm, edges - 1);
+    pio_sm_set_enabled(pio, sm, true);
+}
+
+float quad_encoder_update_velocity(quad_encoder_t *enc, uint32_t now_us) {
+    int32_t count = quad_encoder_raw(enc);
+    if (enc->timing_sm < 0) {
+        return quad_velocity_update(&enc->vel, count, now_us, NULL, 0);
+    }
+
+    // Drain the period FIFO. A full one has dropped periods; then only how many were read matters.
+    uint32_t periods[EDGE_PERIOD_FIFO];
+    uint32_t read = 0;
+    while (!pio_sm_is_rx_fifo_empty(enc->timing_pio, (uint)enc->timing_sm)) {
+        uint32_t period = pio_sm_get(enc->timing_pio, (uint)enc->timing_sm);
+        if (read < EDGE_PERIOD_FIFO) {
+            periods[read] = period;
+        }
+        read++;
+    }
+    return quad_velocity_update(&enc->vel, count, now_us, periods, read);
+}
+
+int32_t quad_encoder_raw(quad_encoder_t *enc) {
+    // Skip the values already queued; the state machine pushes a fresh one on its next pass.
+    uint n = pio_sm_get_rx_fifo_level(enc->pio, enc->sm) + 1;
+    uint32_t count = 0;
+    while (n-- > 0) {
+        count = pio_sm_get_blocking(enc->pio, enc->sm);
+    }
+    return (int32_t)count;
+}
@@ -0,0 +1,190 @@
+/**
+ * @file quad_encoder.h
+ * @author Thomas Chang
+ * @brief PIO based 4x quadrature decoder for the motor encoder.
+ * @details A PIO state machine samples both encoder channels in a tight loop and counts every edge of A and B up or
+ * down from the actual phase order, so the count follows the shaft even when it is back-driven and costs no CPU time
+ * per edge. The state machine keeps pushing its 32 bit count to the RX FIFO; reading the position drains the FIFO and
+ * takes the next value, which arrives within a few PIO cycles.
+ *
+ * The program uses computed jumps and must sit at offset 0 of its PIO block, so other programs on the same block have
+ * to fit behind it.
+ *
+ * Velocity uses the M/T method. A second state machine (quad_encoder_init_timing()) measures the time between the
+ * edges of one channel. On every quad_encoder_update_velocity() call the edges that arrived since the last call are
+ * divided by the exact time they span, which gives period resolution at low speed and count resolution at high speed
+ * with at most one call of latency. When the edges come faster than the period FIFO can hold, the plain count
+ * difference over the call interval is used instead. Without edges the estimate is capped by one edge over the time
+ * since the last one and drops to 0 after the zero-speed timeout. The arithmetic is in quad_velocity.h, which has no
+ * SDK calls and also builds into the host simulator.
+ *
+ * A third, optional state machine (quad_encoder_init_limit()) is a hard travel limit. Armed with a distance, it counts
+ * the edges of one channel down in PIO and raises an interrupt on the edge that reaches the limit; the handler runs
+ * from RAM at the highest priority and calls back within microseconds, whatever the CPU was doing. It resolves 2 counts
+ * (one edge of the channel) and counts edges in either direction, so a wobble, or chatter that quadrature decoding
+ * rejects, makes it trip early; re-arming it often from the decoded position keeps those edges from adding up. An edge
+ * that passes between reading the position and re-arming is not counted, so a re-armed limit may trip up to one edge
+ * late. Arming it at or past the limit calls back at once.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "pico/stdlib.h"
+#include "hardware/pio.h"
+#include "quad_velocity.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Called from the limit interrupt. Must be short and must run from RAM (__not_in_flash_func).
+ *
+ */
+typedef void (*quad_encoder_limit_cb_t)(void);
+
+/**
+ * @brief One decoder instance.
+ *
+ */
+typedef struct {
+    PIO pio;
+    uint sm;
+    int32_t zero;           ///< Raw count that reads as position 0.
+
+    PIO timing_pio;
+    int timing_sm;          ///< Edge period state machine, -1 if quad_encoder_init_timing() was not called.
+    quad_velocity_t vel;    ///< M/T estimate; its count is the raw count at the last velocity update.
+
+    PIO limit_pio;
+    int limit_sm;           ///< Hard limit state machine, -1 if quad_encoder_init_limit() was not called.
+    uint limit_offset;
+    quad_encoder_limit_cb_t limit_cb;
+} quad_encoder_t;
+
+/**
+ * @brief Loads the decoder into a PIO block and starts it with a count of 0.
+ *
+ * @param enc Decoder to set up.
+ * @param pio PIO block. Offset 0 of its instruction memory must be free.
+ * @param pin_base First encoder pin. The other channel must be on pin_base + 1.
+ * @return false if no state machine or no room at offset 0 was left.
+ */
+bool quad_encoder_init(quad_encoder_t *enc, PIO pio, uint pin_base);
+
+/**
+ * @brief Starts edge period measurement on one encoder channel for the M/T velocity estimate.
+ * @details The state machine only reads the pin, so it can run on a different PIO block than the decoder.
+ * @param enc Decoder set up with quad_encoder_init().
+ * @param pio PIO block with room for the edge_period program.
+ * @param pin One of the two encoder pins.
+ * @param zero_us Time without any count after which the shaft is taken to stand still.
+ * @return false if no state machine or program space was left.
+ */
+bool quad_encoder_init_timing(quad_encoder_t *enc, PIO pio, uint pin, uint32_t zero_us);
+
+/**
+ * @brief Sets up the hard travel limit on one encoder channel, disarmed. Only one decoder can have a limit.
+ * @details The state machine only reads the pin, so it can run on a different PIO block than the decoder. Its
+ * interrupt is PIO IRQ 0 of that block at the highest NVIC priority.
+ * @param enc Decoder set up with quad_encoder_init().
+ * @param pio PIO block with room for the limit_watch program.
+ * @param pin One of the two encoder pins.
+ * @param cb Called once when an armed limit is reached.
+ * @return false if no state machine or program space was left.
+ */
+bool quad_encoder_init_limit(quad_encoder_t *enc, PIO pio, uint pin, quad_encoder_limit_cb_t cb);
+
+/**
+ * @brief Arms the hard limit. Replaces a limit that is still armed.
+ * @details The distance is rounded down to whole channel edges. A position at or past the limit in the direction of
+ * travel, or less than one edge before it, calls the callback at once, from the caller's context.
+ * @param enc Decoder.
+ * @param position Position the distance is measured from, e.g. quad_encoder_last().
+ * @param limit Position to stop at.
+ * @param increasing Direction of travel: true if the position grows toward the limit.
+ */
+void quad_encoder_arm_limit(quad_encoder_t *enc, int32_t position, int32_t limit, bool increasing);
+
+/**
+ * @brief Disarms the hard limit.
+ *
+ * @param enc Decoder.
+ */
+void quad_encoder_disarm_limit(quad_encoder_t *enc);
+
+/**
+ * @brief Updates the velocity estimate. Call at a fixed rate from one place only.
+ *
+ * @param enc Decoder.
+ * @param now_us Current time_us_32().
+ * @return float Velocity in counts per second, positive when the count increases.
+ */
+float quad_encoder_update_velocity(quad_encoder_t *enc, uint32_t now_us);
+
+/**
+ * @brief Velocity from the last quad_encoder_update_velocity() call.
+ *
+ * @param enc Decoder.
+ * @return float Counts per second.
+ */
+static inline float quad_encoder_velocity(const quad_encoder_t *enc) {
+    return enc->vel.velocity;
+}
+
+/**
+ * @brief Current raw count of the state machine. Four counts per encoder cycle.
+ *
+ * @param enc Decoder.
+ * @return int32_t Wraps at 32 bits.
+ */
+int32_t quad_encoder_raw(quad_encoder_t *enc);
+
+/**
+ * @brief Position relative to the last quad_encoder_zero().
+ *
+ * @param enc Decoder.
+ * @return int32_t
+ */
+static inline int32_t quad_encoder_get(quad_encoder_t *enc) {
+    return quad_encoder_raw(enc) - enc->zero;
+}
+
+/**
+ * @brief Makes the current position read as 0.
+ *
+ * @param enc Decoder.
+ */
+static inline void quad_encoder_zero(quad_encoder_t *enc) {
+    enc->zero = quad_encoder_raw(enc);
+}
+
+/**
+ * @brief Position at the last quad_encoder_update_velocity() call.
+ * @details Touches no PIO FIFO, so it can be read from another context than the one updating the velocity (e.g. a
+ * timer interrupt that owns the decoder).
+ * @param enc Decoder.
+ * @return int32_t
+ */
+static inline int32_t quad_encoder_last(const quad_encoder_t *enc) {
+    return enc->vel.count - enc->zero;
+}
+
+/**
+ * @brief Makes the position of the last quad_encoder_update_velocity() call read as 0. Same rules as
+ * quad_encoder_last().
+ *
+ * @param enc Decoder.
+ */
+static inline void quad_encoder_zero_last(quad_encoder_t *enc) {
+    enc->zero = enc->vel.count;
+}
+
+#ifdef __cplusplus
+}
+#endif
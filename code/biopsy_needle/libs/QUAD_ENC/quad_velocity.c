@@ -0,0 +1,115 @@
+/**
+ * @file quad_velocity.c
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the M/T velocity estimate of the quadrature decoder.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "quad_velocity.h"
+
+#include <stdlib.h>
+
+void quad_velocity_init(quad_velocity_t *v, float tick_s, uint32_t zero_us, uint32_t now_us) {
+    v->tick_s = tick_s;
+    v->zero_us = zero_us;
+    v->primed = false;
+    v->glitch = (tick_s > 0.0f) ? (uint32_t)(EDGE_GLITCH_US * 1e-6f / tick_s) : 0;
+    v->carry = 0;
+    v->count = 0;
+    v->time_us = now_us;
+    v->idle_us = 0;
+    v->dir = 1;
+    v->velocity = 0.0f;
+}
+
+float quad_velocity_update(quad_velocity_t *v, int32_t count, uint32_t now_us, const uint32_t *periods, uint32_t read) {
+    int32_t dq = count - v->count;
+    uint32_t dt_us = now_us - v->time_us;
+    v->count = count;
+    v->time_us = now_us;
+    if (dt_us == 0) {
+        return v->velocity;
+    }
+
+    // Edge periods since the last update. The first one after a standstill started before it and is thrown away.
+    uint32_t edges = 0;
+    uint64_t span = 0;
+    uint32_t last = 0;      // period counted last in this update
+    uint32_t kept = (read < EDGE_PERIOD_FIFO) ? read : EDGE_PERIOD_FIFO;
+    for (uint32_t k = 0; periods != NULL && k < kept; k++) {
+        uint32_t period = periods[k] + EDGE_PERIOD_OVERHEAD;
+        if (!v->primed) {
+            v->primed = true;
+            v->carry = 0;
+        } else if (period < v->glitch && last > 0) {
+            // A glitch: the level before it ended on its first edge. Both wait for the edge that really ends it.
+            span -= last;
+            edges--;
+            v->carry = last + period;
+            last = 0;
+        } else if (period < v->glitch) {
+            v->primed = false;      // the level before it went into the last update; throw the rest away
+        } else {
+            last = v->carry + period;
+            v->carry = 0;
+            span += last;
+            edges++;
+        }
+    }
+
+    if (dq != 0) {
+        v->dir = (dq > 0) ? 1 : -1;
+        v->idle_us = 0;
+    } else {
+        v->idle_us += dt_us;
+    }
+
+    // A full FIFO has dropped the newest periods. The ones kept still measure the start of the interval, except the
+    // last, which may end on a glitch whose second edge was dropped, and the first one after the drop. More counts
+    // than the periods account for means periods were lost some other way. More periods than the counts account for
+    // (the channel changes at most once per EDGE_COUNTS counts) is chatter longer than a glitch; the period after it
+    // is thrown away too.
+    bool full = (read >= EDGE_PERIOD_FIFO);
+    if (full && last > 0) {
+        span -= last;       // nothing left to tell whether it ended on a glitch
+        edges--;
+    }
+    bool lost = !full && ((uint32_t)abs(dq) > EDGE_COUNTS * (read + 1));
+    bool chatter = EDGE_COUNTS * edges > (uint32_t)abs(dq) + EDGE_COUNTS - 1;
+    if (full || lost || chatter) {
+        v->primed = false;
+    }
+
+    float vel;
+    if (periods == NULL || lost || (chatter && dq != 0)) {
+        vel = dq * 1e6f / dt_us;
+    } else if (edges > 0 && dq != 0) {
+        vel = v->dir * (float)(EDGE_COUNTS * edges) / ((float)span * v->tick_s);
+    } else if (v->idle_us >= v->zero_us) {
+        vel = 0.0f;
+        v->primed = false;
+    } else if (v->idle_us > 0) {
+        // Still turning at most one edge per idle time.
+        float bound = EDGE_COUNTS * 1e6f / v->idle_us;
+        vel = v->velocity;
+        if (vel > bound) {
+            vel = bound;
+        } else if (vel < -bound) {
+            vel = -bound;
+        }
+    } else {
+        vel = v->velocity;
+    }
+
+    v->velocity = vel;
+    return vel;
+}
+
+uint32_t quad_limit_edges(int32_t position, int32_t limit, bool increasing) {
+    int32_t to_go = increasing ? limit - position : position - limit;
+    return (to_go > 0) ? (uint32_t)to_go / EDGE_COUNTS : 0;
+}
@@ -0,0 +1,93 @@
+/**
+ * @file quad_velocity.h
+ * @author Thomas Chang
+ * @brief M/T velocity estimate and hard limit distance of the quadrature decoder, without SDK or PIO calls.
+ * @details quad_encoder.c reads the state machines and hands the count and the edge periods to these functions, so the
+ * same estimator builds into the host simulator (tools/host_sim), which feeds it from a model of the state machines.
+ *
+ * Every update divides the edges that arrived since the last one by the exact time they span. The first period after
+ * a standstill started before it and is thrown away. A full period FIFO has dropped the newest periods, and the ones
+ * it kept are used. More counts than the periods account for means periods were lost otherwise; the plain count
+ * difference over the update interval is used then. Without edges the estimate is held, capped by one edge over the
+ * time since the last count, and drops to 0 after zero_us.
+ *
+ * Chatter on the channel, which quadrature decoding rejects, reaches the period FIFO: a glitch splits a level into a
+ * piece ending on its first edge, the glitch itself and the rest. A level shorter than EDGE_GLITCH_US is taken for a
+ * glitch and the three are put back together into the one level; when the first piece already went into the last
+ * update, the rest is thrown away instead. Longer chatter leaves more periods than the counts account for and falls
+ * back to the count difference.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define EDGE_PERIOD_OVERHEAD    2   ///< Counts edge_period misses per edge: the detecting jmp pin and 3 handler cycles.
+#define EDGE_COUNTS             2   ///< Quadrature counts per edge of a single channel.
+#define EDGE_PERIOD_FIFO        8   ///< Depth of the joined RX FIFO of the edge_period state machine.
+#define EDGE_GLITCH_US          20  ///< Shorter levels are chatter. The motor's shortest real level is ~300 us.
+
+/**
+ * @brief State of the estimator between updates.
+ *
+ */
+typedef struct {
+    float tick_s;           ///< Length of one edge period count in seconds.
+    uint32_t zero_us;       ///< Time without counts after which the velocity is 0.
+    bool primed;            ///< The next period ends an edge that followed another edge (not a standstill).
+    uint32_t glitch;        ///< EDGE_GLITCH_US in edge period counts.
+    uint32_t carry;         ///< Start of a level split by a glitch, added to the period that ends it.
+
+    int32_t count;          ///< Raw count at the last update.
+    uint32_t time_us;       ///< Time of the last update.
+    uint32_t idle_us;       ///< Time since the count last changed.
+    int8_t dir;             ///< Direction of the last count change, +1 or -1.
+    float velocity;         ///< Latest estimate in counts per second.
+} quad_velocity_t;
+
+/**
+ * @brief Starts the estimate at rest.
+ *
+ * @param v Estimator.
+ * @param tick_s Length of one edge period count, 2 system clocks.
+ * @param zero_us Time without any count after which the shaft is taken to stand still.
+ * @param now_us Current time.
+ */
+void quad_velocity_init(quad_velocity_t *v, float tick_s, uint32_t zero_us, uint32_t now_us);
+
+/**
+ * @brief Updates the estimate. Call at a fixed rate.
+ *
+ * @param v Estimator.
+ * @param count Raw count of the decoder now.
+ * @param now_us Current time.
+ * @param periods Edge periods read from the FIFO since the last update, as the state machine pushed them, the first
+ * EDGE_PERIOD_FIFO of them. NULL without edge period measurement: the count difference is used every time.
+ * @param read Number of periods read, which may be more than were kept.
+ * @return float Velocity in counts per second, positive when the count increases.
+ */
+float quad_velocity_update(quad_velocity_t *v, int32_t count, uint32_t now_us, const uint32_t *periods, uint32_t read);
+
+/**
+ * @brief Whole channel edges from a position to a limit in the direction of travel, 0 at or past it.
+ *
+ * @param position Position the distance is measured from.
+ * @param limit Position to stop at.
+ * @param increasing True if the position grows toward the limit.
+ * @return uint32_t Edges to count before the limit is reached.
+ */
+uint32_t quad_limit_edges(int32_t position, int32_t limit, bool increasing);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,46 @@
+#!/usr/bin/env python3
+"""Generates font_x2.h: font_8x5 from font.h pre-scaled by 2 (16x10 glyphs, 2 bytes per column).
+
+Run from this directory after changing font.h:  python3 gen_font_x2.py
+"""
+import re
+
+src = open("font.h").read()
+body = src[src.index("font_8x5[]"):]
+body = body[body.index("{") + 1:body.index("};")]
+vals = [int(v, 0) for v in re.findall(r"0x[0-9A-Fa-f]+|\d+", body)]
+height, width, spacing, first, last = vals[:5]
+data = vals[5:]
+assert height == 8 and len(data) == (last - first + 1) * width
+
+
+def spread(b):
+    """Doubles every bit of a column byte: bit i goes to bits 2i and 2i+1."""
+    v = 0
+    for i in range(8):
+        if b >> i & 1:
+            v |= 3 << (2 * i)
+    return v
+
+
+out = []
+out.append("#ifndef _inc_font_x2")
+out.append("#define _inc_font_x2")
+out.append("")
+out.append("/*")
+out.append(" * Generated by gen_font_x2.py from font_8x5 in font.h. Do not edit.")
+out.append(" * font_8x5 scaled by 2, in the format of font.h. Each column is two bytes, top rows first.")
+out.append(" */")
+out.append("const uint8_t font_8x5_x2[] =")
+out.append("{")
+out.append("\t\t\t%d, %d, %d, %d, %d," % (height * 2, width * 2, spacing * 2, first, last))
+for g in range(last - first + 1):
+    cols = []
+    for w in range(width):
+        v = spread(data[g * width + w])
+        cols += [v & 0xFF, v >> 8] * 2
+    out.append("\t\t\t" + ", ".join("0x%02X" % c for c in cols) + ",")
+out.append("};")
+out.append("")
+out.append("#endif")
+open("font_x2.h", "w").write("\n".join(out) + "\n")
@@ -32,6 +32,7 @@ SOFTWARE.
 
 #include "ssd1306.h"
 #include "font.h"
+#include "font_x2.h"
 
 inline static void swap(int32_t *a, int32_t *b) {
     int32_t *t=a;
@@ -72,8 +73,16 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
         p->bufsize=0;
         return false;
     }
+    if((p->shadow=malloc(p->bufsize))==NULL) {
+        free(p->buffer);
+        p->bufsize=0;
+        return false;
+    }
+    p->shadow_valid=false;
 
     ++(p->buffer);
+    memset(p->chunks, 0, sizeof(p->chunks));
+    p->chunks_queued=0;
 
     // from https://github.com/makerportal/rpi-pico-ssd1306
     uint8_t cmds[]= {
@@ -116,6 +125,7 @@ bool ssd1306_init(ssd1306_t *p, uint16_t width, uint16_t height, uint8_t address
 }
 
 inline void ssd1306_deinit(ssd1306_t *p) {
+    free(p->shadow);
     free(p->buffer-1);
 }
 
@@ -193,11 +203,41 @@ void ssd1306_draw_empty_square(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t wi
     ssd1306_draw_line(p, x+width, y, x+width, y+height);
 }
 
+/**
+	@brief OR one 8 pixel column byte into the buffer at (x, y), straddling two pages when y is not page aligned
+*/
+inline static void ssd1306_blit_column(ssd1306_t *p, uint32_t x, uint32_t y, uint8_t bits) {
+    if(x>=p->width || y>=p->height)
+        return;
+
+    uint32_t shift=y&7;
+    uint8_t *dst=p->buffer+x+p->width*(y>>3);
+    *dst|=(uint8_t)(bits<<shift);
+    if(shift && (y>>3)+1<p->pages)
+        dst[p->width]|=bits>>(8-shift);
+}
+
 void ssd1306_draw_char_with_font(ssd1306_t *p, uint32_t x, uint32_t y, uint32_t scale, const uint8_t *font, char c) {
     if(c<font[3]||c>font[4])
         return;
 
+    // the builtin font has a prescaled copy for scale 2
+    if(scale==2 && font==font_8x5) {
+        font=font_8x5_x2;
+        scale=1;
+    }
+
     uint32_t parts_per_line=(font[0]>>3)+((font[0]&7)>0);
+
+    if(scale==1) {
+        // font data is already column bytes, so copy them whole instead of pixel by pixel
+        const uint8_t *col=font+5+(c-font[3])*font[1]*parts_per_line;
+        for(uint8_t w=0; w<font[1]; ++w)
+            for(uint32_t lp=0; lp<parts_per_line; ++lp)
+                ssd1306_blit_column(p, x+w, y+(lp<<3), *(col++));
+        return;
+    }
+
     for(uint8_t w=0; w<font[1]; ++w) { // width
         uint32_t pp=(c-font[3])*font[1]*parts_per_line+w*parts_per_line+5;
         for(uint32_t lp=0; lp<parts_per_line; ++lp) {
@@ -303,4 +343,129 @@ void ssd1306_show(ssd1306_t *p) {
     *(p->buffer-1)=0x40;
 
     fancy_write(p->i2c_i, p->address, p->buffer-1, p->bufsize+1, "ssd1306_show");
+
+    memcpy(p->shadow, p->buffer, p->bufsize);
+    p->shadow_valid=true;
+}
+
+static const uint8_t ssd1306_data_ctrl=0x40;
+
+bool ssd1306_busy(ssd1306_t *p) {
+    for(uint8_t i=0; i<p->chunks_queued; ++i) {
+        if(i2c_txn_busy(&p->chunks[i].addr_txn) || i2c_txn_busy(&p->chunks[i].data_txn))
+            return true;
+    }
+    return false;
+}
+
+/**
+	@brief queue one window of a page and mark it as sent in the shadow copy
+*/
+static bool ssd1306_queue_window(ssd1306_t *p, uint8_t page, uint8_t col, uint8_t cols) {
+    uint8_t col_offset=(p->width==64)?32:0;
+    ssd1306_chunk_t *c=&p->chunks[p->chunks_queued++];
+
+    // control byte 0x00 followed by the window addressing commands
+    uint8_t cmd[]= {0x00, SET_COL_ADDR, col_offset+col, col_offset+col+cols-1, SET_PAGE_ADDR, page, page};
+    memcpy(c->cmd, cmd, sizeof(cmd));
+
+    i2c_txn_setup(&c->addr_txn, p->address, c->cmd, sizeof(c->cmd), NULL, 0, NULL, NULL);
+    c->addr_txn.deadline_us=SSD1306_FRAME_DEADLINE;
+    i2c_txn_setup(&c->data_txn, p->address, &ssd1306_data_ctrl, 1, NULL, 0, NULL, NULL);
+    c->data_txn.data=p->buffer+page*p->width+col;
+    c->data_txn.data_len=cols;
+    c->data_txn.deadline_us=SSD1306_FRAME_DEADLINE;
+
+    memcpy(p->shadow+page*p->width+col, c->data_txn.data, cols);
+    p->frame_bytes+=SSD1306_WINDOW_COST+cols;
+
+    return i2c_dma_submit(&c->addr_txn) & i2c_dma_submit(&c->data_txn);
+}
+
+/**
+	@brief queue [first, last] of a page as windows of at most SSD1306_CHUNK_COLS columns
+*/
+static bool ssd1306_queue_span(ssd1306_t *p, uint8_t page, uint8_t first, uint8_t last) {
+    bool ok=true;
+    for(uint32_t col=first; col<=last; col+=SSD1306_CHUNK_COLS) {
+        uint32_t cols=last-col+1;
+        if(cols>SSD1306_CHUNK_COLS)
+            cols=SSD1306_CHUNK_COLS;
+        ok&=ssd1306_queue_window(p, page, col, cols);
+    }
+    return ok;
+}
+
+bool ssd1306_show_async(ssd1306_t *p) {
+    if(ssd1306_busy(p))
+        return false;
+
+    // A failed transfer leaves the display RAM unknown, so resend everything.
+    for(uint8_t i=0; i<p->chunks_queued; ++i) {
+        if(p->chunks[i].addr_txn.status!=I2C_TXN_DONE || p->chunks[i].data_txn.status!=I2C_TXN_DONE)
+            p->shadow_valid=false;
+    }
+
+    bool full=!p->shadow_valid;
+    bool ok=true;
+    p->chunks_queued=0;
+    p->frame_bytes=0;
+
+    // Each page gets at most as many windows as a full page needs, so the chunk table can never overflow.
+    const uint8_t budget=(p->width+SSD1306_CHUNK_COLS-1)/SSD1306_CHUNK_COLS;
+
+    for(uint8_t page=0; page<p->pages; ++page) {
+        const uint8_t *now=p->buffer+page*p->width;
+        const uint8_t *was=p->shadow+page*p->width;
+
+        if(full) {
+            ok&=ssd1306_queue_span(p, page, 0, p->width-1);
+            continue;
+        }
+
+        // Find the changed runs, merging runs separated by fewer than SSD1306_MERGE_GAP unchanged columns.
+        uint8_t run_first[SSD1306_MAX_CHUNKS], run_last[SSD1306_MAX_CHUNKS];
+        uint8_t runs=0;
+        bool fits=true;
+        for(uint32_t col=0; col<p->width; ++col) {
+            if(now[col]==was[col])
+                continue;
+            if(runs && col-run_last[runs-1]<=SSD1306_MERGE_GAP) {
+                run_last[runs-1]=col;
+            } else if(runs<budget) {
+                run_first[runs]=col;
+                run_last[runs]=col;
+                ++runs;
+            } else {
+                fits=false;
+                run_last[runs-1]=col;
+            }
+        }
+        if(runs==0)
+            continue;
+
+        for(uint8_t r=0; r<runs; ++r) {
+            if(run_last[r]-run_first[r]+1>SSD1306_CHUNK_COLS)
+                fits=false;
+        }
+
+        if(fits) {
+            for(uint8_t r=0; r<runs; ++r)
+                ok&=ssd1306_queue_window(p, page, run_first[r], run_last[r]-run_first[r]+1);
+        } else {
+            // Too scattered for the window budget: send everything between the first and last change.
+            ok&=ssd1306_queue_span(p, page, run_first[0], run_last[runs-1]);
+        }
+    }
+
+    uint32_t full_cost=SSD1306_WINDOW_COST+p->bufsize;
+    p->saved_bytes=(p->frame_bytes<full_cost)?full_cost-p->frame_bytes:0;
+    p->saved_total+=p->saved_bytes;
+    p->frames++;
+
+    if(!ok)
+        p->shadow_valid=false;
+    else if(full)
+        p->shadow_valid=true;
+    return ok;
 }
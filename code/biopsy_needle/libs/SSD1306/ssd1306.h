@@ -32,6 +32,14 @@ SOFTWARE.
 #define _inc_ssd1306
 #include <pico/stdlib.h>
 #include <hardware/i2c.h>
+#include "../I2C_DMA/i2c_dma.h"
+
+#define SSD1306_MAX_PAGES       8       /**< pages of the largest supported display (64 rows) */
+#define SSD1306_CHUNK_COLS      64      /**< columns sent per transfer by ssd1306_show_async, ~1.7 ms at 400 kHz */
+#define SSD1306_MAX_CHUNKS      (SSD1306_MAX_PAGES*128/SSD1306_CHUNK_COLS)
+#define SSD1306_FRAME_DEADLINE  50000   /**< relative I2C deadline of frame chunks in us, behind any sensor read */
+#define SSD1306_MERGE_GAP       10      /**< unchanged columns worth resending to save a window's addressing overhead */
+#define SSD1306_WINDOW_COST     10      /**< bus bytes of a window besides its data: address, 7 commands, address, 0x40 */
 
 /**
 *	@brief defines commands used in ssd1306
@@ -56,6 +64,15 @@ typedef enum {
     SET_CHARGE_PUMP = 0x8D
 } ssd1306_command_t;
 
+/**
+*	@brief one window of the frame queued by ssd1306_show_async: addressing commands, then the data
+*/
+typedef struct {
+    i2c_txn_t addr_txn;		/**< sets the column and page window */
+    i2c_txn_t data_txn;		/**< control byte 0x40 followed by the window contents */
+    uint8_t cmd[7];			/**< addressing commands */
+} ssd1306_chunk_t;
+
 /**
 *	@brief holds the configuration
 */
@@ -68,6 +85,14 @@ typedef struct {
     bool external_vcc; 	/**< whether display uses external vcc */ 
     uint8_t *buffer;	/**< display buffer */
     size_t bufsize;		/**< buffer size */
+    ssd1306_chunk_t chunks[SSD1306_MAX_CHUNKS];	/**< transfers of ssd1306_show_async */
+    uint8_t chunks_queued;	/**< chunks submitted for the current frame */
+    uint8_t *shadow;		/**< copy of what the display RAM holds, used to send only changed windows */
+    bool shadow_valid;		/**< false until a full frame was sent, or after a failed transfer */
+    uint32_t frame_bytes;	/**< bus bytes of the last ssd1306_show_async frame */
+    uint32_t saved_bytes;	/**< bus bytes the last frame saved compared with sending the whole buffer */
+    uint32_t frames;		/**< frames sent by ssd1306_show_async */
+    uint32_t saved_total;	/**< bus bytes saved over all frames */
 } ssd1306_t;
 
 #ifdef __cplusplus
@@ -139,6 +164,27 @@ void ssd1306_invert(ssd1306_t *p, uint8_t inv);
 */
 void ssd1306_show(ssd1306_t *p);
 
+/**
+	@brief queue the display buffer on the I2C DMA engine and return immediately
+
+	Only the parts of each page that differ from the shadow copy are sent. Changed columns closer than
+	SSD1306_MERGE_GAP are merged into one window; each window is at most SSD1306_CHUNK_COLS wide and is its own
+	transfer with a background deadline, so sensor transactions are scheduled between the chunks instead of waiting
+	for the whole frame. frame_bytes and saved_bytes report the cost of the frame.
+
+	@param[in] p : instance of display
+
+	@return false if the previous frame is still being sent. The buffer must not be changed until ssd1306_busy() is false.
+*/
+bool ssd1306_show_async(ssd1306_t *p);
+
+/**
+	@brief whether a frame queued by ssd1306_show_async is still being sent
+
+	@param[in] p : instance of display
+*/
+bool ssd1306_busy(ssd1306_t *p);
+
 /**
 	@brief clear display buffer
 
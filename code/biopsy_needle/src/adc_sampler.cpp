@@ -0,0 +1,161 @@
+/**
+ * @file adc_sampler.cpp
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the free-running, DMA fed ADC sampler.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "include/adc_sampler.h"
+
+#include "pico/stdlib.h"
+#include "hardware/adc.h"
+#include "hardware/dma.h"
+#include "hardware/clocks.h"
+#include <string.h>
+
+#define ADC_RING_BYTES  (ADC_RING_SAMPLES * sizeof(uint16_t))
+#define ADC_RING_GUARD  16              ///< Samples kept between the reader and the DMA write pointer.
+#define ADC_DMA_COUNT   0xFFFFFFFFu     ///< Transfer count the DMA is started with; counts down one per sample.
+#define ADC_RESTART_AT  0x80000000u     ///< Restart the stream well before the transfer count runs out (~6 days).
+
+static_assert((ADC_RING_SAMPLES & (ADC_RING_SAMPLES - 1)) == 0, "ADC_RING_SAMPLES must be a power of two");
+
+static uint16_t ring[ADC_RING_SAMPLES] __attribute__((aligned(ADC_RING_BYTES)));
+static int dma_chan = -1;
+static uint8_t mask = 0;
+
+static uint8_t order[ADC_NUM_INPUTS];   ///< Input converted at each step of the round robin.
+static uint8_t order_len = 0;
+static uint8_t phase = 0;               ///< Index into order of the sample at position consumed.
+static uint32_t consumed = 0;           ///< Stream position of the next sample to average.
+
+static uint32_t acc_sum[ADC_NUM_INPUTS];
+static uint16_t acc_n[ADC_NUM_INPUTS];
+static q16_t value[ADC_NUM_INPUTS];     ///< Last finished average per input number.
+static uint8_t ready = 0;               ///< Bit n set once input n has published a value.
+static adc_sampler_stats_t stats;
+
+/**
+ * @brief Stops the ADC and DMA, then restarts the round robin at the first selected input with an empty ring.
+ *
+ */
+static void start_stream() {
+    adc_run(false);
+    dma_channel_abort(dma_chan);
+    while (!adc_fifo_is_empty() || !(adc_hw->cs & ADC_CS_READY_BITS)) {
+        adc_fifo_drain();
+    }
+
+    consumed = 0;
+    phase = 0;
+    memset(acc_sum, 0, sizeof(acc_sum));
+    memset(acc_n, 0, sizeof(acc_n));
+
+    adc_select_input(order[0]);
+    adc_set_round_robin(order_len > 1 ? mask : 0);
+    dma_channel_set_write_addr(dma_chan, ring, false);
+    dma_channel_set_trans_count(dma_chan, ADC_DMA_COUNT, true);
+    adc_run(true);
+}
+
+void adc_sampler_init(uint8_t input_mask, uint32_t sample_hz) {
+    mask = input_mask & ((1u << ADC_NUM_INPUTS) - 1);
+
+    // The round robin visits the selected inputs in ascending order, starting from the one selected when it starts.
+    order_len = 0;
+    for (uint8_t in = 0; in < ADC_NUM_INPUTS; in++) {
+        if (mask & (1u << in)) {
+            order[order_len++] = in;
+        }
+    }
+    if (order_len == 0) {
+        return;
+    }
+
+    // One conversion every (1 + div) cycles of the 48 MHz ADC clock. A conversion itself takes 96 cycles.
+    adc_init();
+    if (mask & (1u << 4)) {
+        adc_set_temp_sensor_enabled(true);
+    }
+    adc_fifo_setup(true, true, 1, false, false);
+    float div = (float)clock_get_hz(clk_adc) / sample_hz - 1.0f;
+    adc_set_clkdiv(div < 95.0f ? 0.0f : div);
+
+    // Write side wraps on the ring, so the DMA never has to be re-armed.
+    if (dma_chan < 0) {
+        dma_chan = dma_claim_unused_channel(true);
+    }
+    dma_channel_config c = dma_channel_get_default_config(dma_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, false);
+    channel_config_set_write_increment(&c, true);
+    channel_config_set_ring(&c, true, __builtin_ctz(ADC_RING_BYTES));
+    channel_config_set_dreq(&c, DREQ_ADC);
+    dma_channel_configure(dma_chan, &c, ring, &adc_hw->fifo, 0, false);
+
+    ready = 0;
+    for (uint8_t in = 0; in < ADC_NUM_INPUTS; in++) {
+        value[in] = q16_t();
+    }
+    memset(&stats, 0, sizeof(stats));
+    start_stream();
+}
+
+void adc_sampler_update() {
+    if (dma_chan < 0 || order_len == 0) {
+        return;
+    }
+
+    uint32_t produced = ADC_DMA_COUNT - dma_channel_hw_addr(dma_chan)->transfer_count;
+    uint32_t pending = produced - consumed;
+
+    // The DMA lapped the reader: skip to the oldest sample that is still safe to read and drop partial averages.
+    if (pending > ADC_RING_SAMPLES - ADC_RING_GUARD) {
+        uint32_t drop = pending - (ADC_RING_SAMPLES - ADC_RING_GUARD);
+        stats.overruns += drop;
+        consumed += drop;
+        phase = consumed % order_len;
+        memset(acc_sum, 0, sizeof(acc_sum));
+        memset(acc_n, 0, sizeof(acc_n));
+    }
+
+    while (consumed != produced) {
+        uint8_t in = order[phase];
+        acc_sum[phase] += ring[consumed & (ADC_RING_SAMPLES - 1)];
+        if (++acc_n[phase] == ADC_AVG_SAMPLES) {
+            value[in] = q16_t::from_raw((int32_t)(((uint64_t)acc_sum[phase] << 16) / ADC_AVG_SAMPLES));
+            ready |= (uint8_t)(1u << in);
+            acc_sum[phase] = 0;
+            acc_n[phase] = 0;
+            stats.blocks++;
+        }
+        if (++phase == order_len) {
+            phase = 0;
+        }
+        consumed++;
+        stats.samples++;
+    }
+
+    if (consumed >= ADC_RESTART_AT) {
+        start_stream();
+    }
+}
+
+q16_t adc_sampler_read(uint8_t input) {
+    return (input < ADC_NUM_INPUTS) ? value[input] : q16_t();
+}
+
+void adc_sampler_wait_ready() {
+    while (order_len > 0 && (ready & mask) != mask) {
+        adc_sampler_update();
+        sleep_ms(1);
+    }
+}
+
+adc_sampler_stats_t adc_sampler_stats() {
+    return stats;
+}
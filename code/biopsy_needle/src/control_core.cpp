@@ -0,0 +1,234 @@
+/**
+ * @file control_core.cpp
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the control core: state machine, filters and safety checks.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "include/control_core.h"
+#include "include/control_hal.h"
+#include "include/dsp_filters.h"
+#include "include/sensor_units.h"
+
+#include <math.h>
+
+// ==== Experimental Values ==== //
+int fwRev = 50;
+int bwRev = 0;
+
+enum states state, nextState;
+float targetRpm = 0;
+long temp_speed = 0;
+long bat_per = 0;
+int count = 0;
+float rpm = 0;
+float rpmFiltered = 0;
+q16_t current_mA;
+q16_t lp_current;
+q16_t force;
+q16_t forceFiltered;
+q16_t displacement;
+stall_detector_t stall;
+motion_profile_t profile;
+
+// ==== Filter Pipelines (see dsp_filters.h) ==== //
+static MovingAverage<q16_t, MAF_SZ> currentMAF;
+static OnePole<q16_t> currentLP(LP_ALPHA);
+static FilterChain<q16_t, RunningMedian<q16_t, FORCE_MED>, OnePole<q16_t>> forcePipeline{RunningMedian<q16_t, FORCE_MED>(), OnePole<q16_t>(FORCE_ALPHA)};
+static Kalman1D<float> rpmPipeline(RPM_Q, RPM_R);
+
+static void resetFiltering() {
+    // Initialize all moving average filter values to zero.
+    currentMAF.reset();
+
+    // Reset previous low pass output.
+    currentLP.reset();
+    lp_current = q16_t();
+}
+
+void control_init() {
+    static constexpr stall_config_t stallCfg = {STALL_PWM_MIN, MOTOR_ON, STALL_ARM_COUNTS, STALL_START_US,
+                                                STALL_VEL_FRAC, 60e6f / (ENCODER_CPR * ENCODER_GEAR),
+                                                q16_t::from_double(STALL_SLOPE_MA_MS), q16_t::from_double(STALL_RISE_MA),
+                                                q16_t::from_double(STALL_MIN_MA), STALL_CONFIRM_US};
+    stall_init(&stall, &stallCfg);
+    static constexpr motion_profile_config_t profileCfg = {PROFILE_ACCEL, PROFILE_JERK, PROFILE_MIN_RPM, PROFILE_TOL_REV};
+    motion_profile_init(&profile, &profileCfg);
+    state = WAIT;
+    nextState = STANDBY;
+}
+
+/**
+ * @details State entry actions (mounting, closing files) run once on the first tick in a state instead of every tick.
+ * The stall detector sees the motor command that has been applied since the previous tick; a stall ends homing and
+ * stops cutting or exiting like a travel limit does. Cutting and exiting follow an S-curve profile to fwRev and bwRev,
+ * which ends the state when it arrives. The speed control loop cuts the PWM at the limit itself (predictive stop, and a
+ * hard limit in PIO behind it), so the check here only has to notice it; the travel limits stay as a last backstop.
+ */
+void control_tick(int32_t position, float speed_rpm, bool motor_dir, uint16_t motor_power, uint32_t now_us) {
+    static enum states prevState = ZERO;
+
+    count = position;
+    rpm = fabsf(speed_rpm);
+    rpmFiltered = rpmPipeline.update(rpm);
+    q16_t revs = getRevolutions(count);
+    displacement = revs * MM_PER_REV;
+    bool stalled = stall_update(&stall, motor_dir, motor_power, count, rpm, current_mA, now_us) == STALL_DETECTED;
+
+    bool entry = (state != prevState);
+    prevState = state;
+
+    switch(state) {
+        case WAIT: {
+            if (entry) {
+                hal_send(MSG_MSC_ON);
+            }
+            hal_speed_stop();
+            nextState = STANDBY;
+            break;
+        }
+        case STANDBY: {
+            if (entry) {
+                hal_send(MSG_MSC_OFF);
+            }
+            hal_speed_stop();
+            targetRpm = temp_speed * (SPEED_MAX_RPM / 100.0f);
+            resetFiltering();
+            nextState = CUTTING;
+            break;
+        }
+        case CUTTING: {
+            if (entry) {
+                motion_profile_start(&profile, revs.to_float(), (float)fwRev, targetRpm);
+                hal_speed_limit(getCounts(fwRev));
+            }
+            float setpoint = motion_profile_update(&profile, revs.to_float(), 1.0f / CONTROL_HZ);
+            // ==== SAFETY CHECK ==== //
+            if (revs > q16_t(fwRev) || stalled || motion_profile_done(&profile) || hal_speed_at_limit()) {
+                motion_profile_stop(&profile);
+                hal_speed_stop();
+                state = REMOVAL;
+            } else {
+                hal_speed_set(MOTOR_FW, setpoint);
+            }
+            nextState = REMOVAL;
+            break;
+        }
+        case REMOVAL: {
+            hal_speed_stop();
+            targetRpm = temp_speed * (SPEED_MAX_RPM / 100.0f);
+            resetFiltering();
+            nextState = EXITING;
+            break;
+        }
+        case EXITING: {
+            if (entry) {
+                motion_profile_start(&profile, revs.to_float(), (float)bwRev, targetRpm);
+                hal_speed_limit(getCounts(bwRev));
+            }
+            float setpoint = motion_profile_update(&profile, revs.to_float(), 1.0f / CONTROL_HZ);
+            // ==== SAFETY CHECK ==== //
+            if (revs < q16_t(bwRev) || stalled || motion_profile_done(&profile) || hal_speed_at_limit()) {
+                motion_profile_stop(&profile);
+                hal_speed_stop();
+                state = FINISH;
+            } else {
+                hal_speed_set(MOTOR_BW, setpoint);
+            }
+            nextState = FINISH;
+            break;
+        }
+        case FINISH: {
+            if (entry) {
+                hal_send(MSG_CLOSE_LOG);
+                hal_run_finish();
+            }
+            hal_speed_stop();
+            nextState = STANDBY;
+            break;
+        }
+        case ZERO: {
+            hal_speed_open_loop(MOTOR_BW, MOTOR_ON);
+
+            // Reaching the housing stalls the motor.
+            if (stalled) {
+                hal_speed_zero();
+                hal_speed_clear_limit();
+                count = 0;
+                state = FINISH;
+            }
+            nextState = FINISH;
+            break;
+        }
+    }
+}
+
+void control_current(bool fresh, q16_t mA, uint16_t pwm, uint32_t time_us) {
+    if (fresh) {
+        current_mA = mA;
+    }
+    q16_t MAF_current = currentMAF.update(current_mA);
+    lp_current = currentLP.update(current_mA);
+
+    if (state == CUTTING || state == EXITING) {
+        log_record_t rec;
+        rec.state = state;
+        rec.time_us = time_us;
+        rec.current_mA = current_mA;
+        rec.lp_current = lp_current;
+        rec.maf_current = MAF_current;
+        rec.pwm = pwm;
+        rec.rpm = rpm;
+        rec.displacement = displacement;
+        rec.force = force;
+        hal_log(&rec);
+    }
+}
+
+void control_force(q16_t newtons) {
+    force = newtons;
+    forceFiltered = forcePipeline.update(force);
+}
+
+void control_inputs(long speed_pct, long battery_pct) {
+    bat_per = battery_pct;
+    if (state == STANDBY || state == REMOVAL) {
+        temp_speed = speed_pct;
+    }
+}
+
+void control_release() {
+    state = nextState;
+    if (state == CUTTING) {
+        hal_run_start();
+        hal_send(MSG_OPEN_LOG);
+    }
+}
+
+void control_hold() {
+    state = ZERO;
+    nextState = FINISH;
+    hal_speed_open_loop(MOTOR_BW, MOTOR_ON);
+}
+
+void control_snapshot(status_snapshot_t* snap) {
+    snap->state = state;
+    snap->current_mA = current_mA;
+    snap->rpm = rpmFiltered;
+    snap->displacement = displacement;
+    snap->force = forceFiltered;
+    snap->bat_per = bat_per;
+    snap->temp_speed = temp_speed;
+}
+
+q16_t getRevolutions(int count) {
+    return countsToRev(count);
+}
+
+int32_t getCounts(int revolutions) {
+    return (int32_t)lroundf(revolutions * (ENCODER_CPR * ENCODER_GEAR));
+}
@@ -0,0 +1,64 @@
+/**
+ * @file core_link.cpp
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the inter-core record ring and snapshot.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "include/core_link.h"
+#include "include/seqlock.h"
+
+#include "pico/stdlib.h"
+
+static SpscRing<log_record_t, LOG_RING_DEPTH> log_ring;
+static Seqlock<status_snapshot_t> snapshot;
+static Seqlock<run_settings_t> run_settings;
+
+bool core_link_push_record(log_record_t* rec) {
+    rec->kind = MSG_RECORD;
+    return log_ring.push(*rec);
+}
+
+void core_link_send(uint8_t kind) {
+    log_record_t msg = {};
+    msg.kind = kind;
+    while (!log_ring.try_push(msg)) {
+        tight_loop_contents();
+    }
+}
+
+uint32_t core_link_peek(const log_record_t** span) {
+    return log_ring.peek_span(span);
+}
+
+void core_link_release(uint32_t count) {
+    log_ring.release(count);
+}
+
+ring_stats_t core_link_stats() {
+    return log_ring.stats();
+}
+
+void core_link_reset_stats() {
+    log_ring.reset_stats();
+}
+
+void core_link_publish(const status_snapshot_t* snap) {
+    snapshot.write(*snap);
+}
+
+status_snapshot_t core_link_snapshot() {
+    return snapshot.read();
+}
+
+void core_link_publish_run(const run_settings_t* run) {
+    run_settings.write(*run);
+}
+
+run_settings_t core_link_run() {
+    return run_settings.read();
+}
@@ -0,0 +1,75 @@
+/**
+ * @file adc_sampler.h
+ * @author Thomas Chang
+ * @brief Prototypes for the free-running, DMA fed ADC sampler. Core 0 only.
+ * @details The ADC converts the selected inputs in round-robin order at a fixed rate and DMA copies every result into a
+ * ring buffer, so sampling costs no CPU time at all. adc_sampler_update() walks the samples that arrived since its
+ * last call and averages them per input in blocks of ADC_AVG_SAMPLES (decimation). The last finished block of every
+ * input is cached, so reading a value is O(1).
+ *
+ * The stream position comes from the DMA transfer counter, which tells both where the newest sample is in the ring and
+ * which input produced it. If update is not called for longer than the ring covers, the oldest samples are dropped
+ * and counted as an overrun. The rate and the input set are parameters, so a fast input such as a motor current
+ * shunt can be added to the round robin later by raising ADC_SAMPLE_HZ and ADC_RING_SAMPLES.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "fixed_point.h"
+
+#define ADC_NUM_INPUTS      5                   ///< Inputs 0-3 are GPIO 26-29, input 4 is the temperature sensor.
+#define ADC_SAMPLE_HZ       4000                ///< Conversions per second over all inputs together.
+#define ADC_RING_SAMPLES    1024                ///< Ring length. Power of two; covers 256 ms at ADC_SAMPLE_HZ.
+#define ADC_AVG_SAMPLES     128                 ///< Samples averaged per input into one output value.
+
+/**
+ * @brief Counters of the sampler since it was started.
+ *
+ */
+typedef struct {
+    uint32_t samples;       ///< Samples consumed by adc_sampler_update().
+    uint32_t blocks;        ///< Averages published over all inputs.
+    uint32_t overruns;      ///< Samples overwritten before update() reached them.
+} adc_sampler_stats_t;
+
+/**
+ * @brief Configures round-robin conversion of the given inputs and starts the ADC and its DMA channel.
+ * @details The GPIOs still have to be set up with adc_gpio_init().
+ * @param input_mask Bit n selects ADC input n.
+ * @param sample_hz Total conversions per second over all selected inputs.
+ */
+void adc_sampler_init(uint8_t input_mask, uint32_t sample_hz);
+
+/**
+ * @brief Averages the samples that arrived since the last call. Call at least every ADC_RING_SAMPLES / sample_hz s.
+ *
+ */
+void adc_sampler_update();
+
+/**
+ * @brief Latest average of an input in ADC counts (0-4095), with the fraction of the average kept.
+ *
+ * @param input ADC input number.
+ * @return q16_t Mean of the last finished block, 0 before the first block.
+ */
+q16_t adc_sampler_read(uint8_t input);
+
+/**
+ * @brief Blocks until every selected input has published its first average.
+ *
+ */
+void adc_sampler_wait_ready();
+
+/**
+ * @brief Counters since adc_sampler_init().
+ *
+ * @return adc_sampler_stats_t
+ */
+adc_sampler_stats_t adc_sampler_stats();
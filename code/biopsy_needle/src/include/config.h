@@ -19,14 +19,148 @@
 // General timing
 #define debounce_us   100000
 #define hold_us       3000000   ///< Hold [STATE] for 3 sec to enter ZERO state.
-#define potIterations 1000
 #define debug_us      5000000
 
 
-//==== ZERO STATE ====//
-#define SPIKE_TIME      500     ///< Time in ms used to avoid measuring current spikes during the ZERO state. Without this the ZERO state will exit immediately as it will detect motor startup spikes as collision with the housing.
-#define CUTOFF_STALL    800.0f  ///< Stall current that determines when the ZERO state is complete. If the device detects this current, it will be because it has reached the housing.
-//==== ZERO STATE ====//
+//==== RATE GROUPS ====//
+/**
+ * @defgroup RateGroups Rate Groups
+ * Release rates of the scheduler tasks. Each must divide SCHED_BASE_HZ (see scheduler.h).
+ * @{
+ */
+#define CONTROL_HZ      1000    ///< Buttons, encoder position, travel limits and the state machine.
+#define CURRENT_HZ      500     ///< INA219 current, filtering and data logging.
+#define FORCE_HZ        100     ///< FX29 load cell.
+#define DISPLAY_HZ      10      ///< OLED, battery level and speed potentiometer.
+/** @} */
+//==== RATE GROUPS ====//
+
+
+//==== DATA LOGGING ====//
+/**
+ * @defgroup LogMacros Data Logging Macros
+ * Selects the run log format. The binary format (see runlog_format.h) is the default; tools/runlog_convert turns it
+ * into the CSV layout below. Build with -DLOG_CSV=1 to write the CSV on the device instead.
+ * @{
+ */
+#ifndef LOG_CSV
+#define LOG_CSV         0
+#endif
+
+#if LOG_CSV
+#define LOG_EXT         "csv"
+#else
+#define LOG_EXT         "bin"
+#endif
+
+#define FW_VERSION      "1.0"       ///< Written to the run log header together with FW_GIT_REV.
+#ifndef FW_GIT_REV
+#define FW_GIT_REV      "unknown"   ///< Source revision, set by CMake from git describe.
+#endif
+/** @} */
+//==== DATA LOGGING ====//
+
+
+//==== ENCODER ====//
+/**
+ * @defgroup EncoderMacros Encoder Macros
+ * Scaling of the PIO quadrature decoder (see libs/QUAD_ENC).
+ * @{
+ */
+#define ENCODER_CPR     48          ///< Counts per motor revolution: 12 pulses per channel, counted on all 4 edges.
+#define ENCODER_GEAR    34.014f     ///< Gearbox ratio (motor revolutions per output revolution).
+#define ENCODER_SIGN    1           ///< Set to -1 if the count decreases while the motor runs forward.
+#define ENCODER_ZERO_US 50000       ///< No count for this long reads as 0 RPM (about 1.5 output RPM is the slowest seen).
+/** @} */
+//==== ENCODER ====//
+
+
+//==== CURRENT SENSE ====//
+/**
+ * @defgroup CurrentMacros Current Sense Macros
+ * INA219 calibration. The current register then counts INA219_MAX_AMPS / 32768 A per LSB (0.0977 mA).
+ * @{
+ */
+#define INA219_SHUNT_OHMS   0.1     ///< Shunt resistor on the INA219 breakout.
+#define INA219_MAX_AMPS     3.2     ///< Largest expected current; sets the current LSB.
+/** @} */
+//==== CURRENT SENSE ====//
+
+
+//==== SPEED CONTROL ====//
+/**
+ * @defgroup SpeedMacros Speed Control Macros
+ * Closed-loop speed control of the needle (see speed_control.h). Speeds are output shaft RPM, outputs PWM levels.
+ * @{
+ */
+#define SPEED_CTRL_HZ       1000        ///< Rate of the control loop timer interrupt.
+#define SPEED_MAX_RPM       150.0f      ///< Target at 100 % on the speed potentiometer. Kept below SPEED_FREE_RPM so load can be made up.
+#define SPEED_FREE_RPM      200.0f      ///< Unloaded speed at full PWM on a nominal battery; sets the feed-forward.
+#define SPEED_KFF           (MOTOR_ON / SPEED_FREE_RPM)     ///< Feed-forward PWM levels per target RPM.
+#define SPEED_FF0           10.0f       ///< Feed-forward offset to overcome static friction.
+#define SPEED_KP            2.0f        ///< PWM levels per RPM of error.
+#define SPEED_KI            40.0f       ///< PWM levels per RPM second of error.
+#define SPEED_KD            0.0f        ///< PWM levels per RPM/s; the M/T speed is too coarse at low speed for much D.
+#define SPEED_D_ALPHA       0.2f        ///< Smoothing of the D term.
+#define SPEED_SLEW          2000.0f     ///< Largest PWM change per second (0 to full in ~130 ms).
+/** @} */
+//==== SPEED CONTROL ====//
+
+
+//==== MOTION PROFILE ====//
+/**
+ * @defgroup ProfileMacros Motion Profile Macros
+ * Limits of the S-curve profile that takes the needle to fwRev while cutting and back to bwRev while exiting
+ * (see motion_profile.h). The speed potentiometer sets the cruise speed.
+ * @{
+ */
+#define PROFILE_ACCEL       600.0f      ///< Largest acceleration, RPM/s (0 to SPEED_MAX_RPM in ~0.35 s).
+#define PROFILE_JERK        6000.0f     ///< Largest change of acceleration, RPM/s^2 (full acceleration after 0.1 s).
+#define PROFILE_MIN_RPM     5.0f        ///< Slowest setpoint short of the target, above what friction holds back.
+#define PROFILE_TOL_REV     0.0f        ///< Within this many output revolutions the target is reached. 0: the end-of-travel stop cuts the PWM there.
+/** @} */
+//==== MOTION PROFILE ====//
+
+
+//==== END OF TRAVEL ====//
+/**
+ * @defgroup StopMacros End of Travel Macros
+ * Predictive stop at fwRev/bwRev, run by the speed control loop (see stop_predict.h). The coast time (distance coasted
+ * after the cut over the speed at the cut) is learned from every stop; these are the starting value and its bounds. Behind it a hard limit in PIO cuts the PWM
+ * from an interrupt if the needle gets further.
+ * @{
+ */
+#define STOP_COAST_S        0.025f      ///< Coast time after the PWM is cut, before anything was learned.
+#define STOP_COAST_MIN      0.002f      ///< Shortest learned coast time, s.
+#define STOP_COAST_MAX      0.2f        ///< Longest learned coast time, s.
+#define STOP_LEARN          0.5f        ///< Weight of the last stop in the learned coast time.
+#define STOP_HARD_MARGIN    16          ///< The hard limit in PIO sits this many counts (~5 um) past the predicted stop. It is re-armed from the quadrature position every control tick.
+/// False-trip budget of the hard limit. The PIO counts every edge of channel A, also chatter and dither that quadrature
+/// decoding rejects, but only since the last control tick. With the needle at its predicted stop, up to
+/// STOP_HARD_MARGIN / 2 - 1 = 7 such edges (3 dither cycles) within one SPEED_CTRL_HZ period are tolerated; the 8th
+/// cuts the PWM short of the target by at most the distance still to go. Further away the budget is larger by one edge
+/// for every 2 counts to go.
+/** @} */
+//==== END OF TRAVEL ====//
+
+
+//==== STALL DETECTION ====//
+/**
+ * @defgroup StallMacros Stall Detection Macros
+ * Tuning of the stall detector (see stall_detect.h). It ends the ZERO state when the needle reaches the housing and
+ * stops CUTTING/EXITING on a collision.
+ * @{
+ */
+#define STALL_PWM_MIN       40          ///< Commands below this PWM level are not watched; the motor may not move at all.
+#define STALL_ARM_COUNTS    96          ///< Encoder counts (2 motor revolutions) of travel before collisions are watched.
+#define STALL_START_US      60000       ///< Powered but no encoder count for this long is a stall. Above the ~25 ms count period at the slowest speed seen. Only the backstop once running; collisions are caught by the speed collapse at any speed.
+#define STALL_VEL_FRAC      0.5f        ///< Speed below this fraction of the normal speed counts as a collapse.
+#define STALL_SLOPE_MA_MS   20.0        ///< Current rising at least this fast (mA/ms) at full PWM counts as a load step. Scaled with the commanded PWM.
+#define STALL_RISE_MA       250.0       ///< Current this far above the normal current at full PWM counts as a load step. Scaled with the commanded PWM.
+#define STALL_MIN_MA        200.0       ///< Current that shows the motor is really powered.
+#define STALL_CONFIRM_US    2000        ///< Collapse and load step must hold this long.
+/** @} */
+//==== STALL DETECTION ====//
 
 
 
@@ -0,0 +1,148 @@
+/**
+ * @file control_core.h
+ * @author Thomas Chang
+ * @brief Prototypes for the control core: the state machine, the sensor filters, the safety checks and the log records.
+ * @details The core is plain C++ without SDK or hardware calls, so the same source builds into the firmware and into
+ * the host simulator (tools/host_sim). The platform feeds it measurements from its rate groups and button handling
+ * and carries out its commands through control_hal.h:
+ *
+ *  - control_tick()    at CONTROL_HZ: position and speed from the speed controller; runs the state machine.
+ *  - control_current() at CURRENT_HZ: motor current; filters it and logs a sample while cutting or exiting.
+ *  - control_force()   at FORCE_HZ: load cell force.
+ *  - control_inputs()  at DISPLAY_HZ: speed potentiometer and battery level.
+ *  - control_release() / control_hold(): a valid button release, a button held for hold_us.
+ *
+ * The state and the latest values are kept in the globals below for the display, the log header and the reports.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "config.h"
+#include "fixed_point.h"
+#include "core_link.h"
+#include "stall_detect.h"
+#include "motion_profile.h"
+
+// ==== Experimental Values ==== //
+#define MAF_SZ      5       ///< Window size for Moving Average Filter.
+#define LP_ALPHA    0.1f    ///< Smoothing factor for LP Filter
+#define FORCE_MED   3       ///< Median window of the force pipeline. Rejects single sample spikes of the load cell.
+#define FORCE_ALPHA 0.3f    ///< Smoothing factor of the force pipeline after the median.
+#define RPM_Q       25.0f   ///< Kalman process noise of the displayed RPM, RPM^2 per control tick.
+#define RPM_R       400.0f  ///< Kalman measurement noise of the M/T RPM estimate, RPM^2.
+
+constexpr q16_t MM_PER_REV = q16_t::from_double(0.5);           ///< Needle travel per output revolution.
+
+// ==== Motor State Machine ==== //
+enum states {
+    WAIT,
+    STANDBY,
+    CUTTING,
+    REMOVAL,
+    EXITING,
+    FINISH,
+    ZERO
+};
+
+extern enum states state, nextState;
+extern int fwRev;           ///< Sets the max forward revolutions of the device from start position. Current ratio of (revolutions : distance) = (2 : 1)
+extern int bwRev;           ///< Sets the max backwards revolutions of the device from start position. Current ratio of (revolutions : distance) = (2 : 1)
+extern float targetRpm;     ///< Speed the controller holds while cutting or exiting, from the potentiometer.
+extern long temp_speed;     ///< Selected speed in percent.
+extern long bat_per;        ///< Battery level in percent.
+extern int count;           ///< Encoder position at the last control tick.
+extern float rpm;           ///< Output speed at the last control tick, magnitude.
+extern float rpmFiltered;
+extern q16_t current_mA;
+extern q16_t lp_current;
+extern q16_t force;
+extern q16_t forceFiltered;
+extern q16_t displacement;
+extern stall_detector_t stall;
+extern motion_profile_t profile;   ///< Move of the current CUTTING or EXITING state.
+
+/**
+ * @brief Sets up the stall detector and the motion profile and enters WAIT.
+ *
+ */
+void control_init();
+
+/**
+ * @brief Control rate group body. Tracks position, enforces the travel limits, and advances the state machine.
+ *
+ * @param position Encoder count, positive forward.
+ * @param speed_rpm Output shaft speed, positive forward.
+ * @param motor_dir Direction applied to the motor since the previous tick.
+ * @param motor_power PWM level applied to the motor since the previous tick.
+ * @param now_us Current time in microseconds.
+ */
+void control_tick(int32_t position, float speed_rpm, bool motor_dir, uint16_t motor_power, uint32_t now_us);
+
+/**
+ * @brief Current rate group body.
+ *
+ * @param fresh A new conversion was read; otherwise the previous current is held.
+ * @param mA Motor current.
+ * @param pwm PWM level at the time of the sample, for the log.
+ * @param time_us Ideal release time of the sample, used as the log timestamp.
+ */
+void control_current(bool fresh, q16_t mA, uint16_t pwm, uint32_t time_us);
+
+/**
+ * @brief Force rate group body. Only valid new readings should be passed.
+ *
+ * @param newtons Load cell force.
+ */
+void control_force(q16_t newtons);
+
+/**
+ * @brief Input rate group body.
+ *
+ * @param speed_pct Speed potentiometer in percent; only taken while a speed can be chosen.
+ * @param battery_pct Battery level in percent.
+ */
+void control_inputs(long speed_pct, long battery_pct);
+
+/**
+ * @brief A valid short press was released: moves on to nextState. Starting a cut opens a new run log.
+ *
+ */
+void control_release();
+
+/**
+ * @brief The button was held for hold_us: homes the needle (ZERO).
+ *
+ */
+void control_hold();
+
+/**
+ * @brief Fills the values shown on the OLED.
+ *
+ * @param snap Snapshot to fill.
+ */
+void control_snapshot(status_snapshot_t* snap);
+
+/**
+ * @brief Takes detected motor signals and converts them to the real-world number of revolutions of the motor shaft.
+ *
+ * @details The conversion is as follows: number_of_counts * (1 small revolution / ENCODER_CPR counts) * (1 big revolution / ENCODER_GEAR small revolutions). ENCODER_GEAR is the gear ratio whilst the (small revolutions / counts) is from the motor documentation.
+ * The factor is folded into a fixed point multiplier at compile time, so this is one integer multiply (see fixed_point.h).
+ * @param count Number of encoder edges counted by the quadrature decoder (see quad_encoder.h).
+ * @return q16_t Revolutions of the output shaft.
+ */
+q16_t getRevolutions(int count);
+
+/**
+ * @brief Inverse of getRevolutions(): the encoder count at a number of output shaft revolutions.
+ *
+ * @param revolutions Output shaft revolutions.
+ * @return int32_t Encoder count, rounded.
+ */
+int32_t getCounts(int revolutions);
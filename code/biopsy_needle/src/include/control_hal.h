@@ -0,0 +1,78 @@
+/**
+ * @file control_hal.h
+ * @author Thomas Chang
+ * @brief Everything the control core (control_core.h) needs from the platform it runs on.
+ * @details The core never touches hardware or the SDK. It drives the motor, the log and the run statistics through
+ * these calls, which the firmware implements in main.cpp on top of speed_control.h and core_link.h, and the host
+ * simulator (tools/host_sim) implements on top of its motor and sensor models. All of them are called from the
+ * control core only, i.e. from the rate group tasks on core 0.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "core_link.h"
+
+/**
+ * @brief Closed-loop speed in one direction, see speed_control_set().
+ *
+ */
+void hal_speed_set(bool direction, float target_rpm);
+
+/**
+ * @brief Fixed PWM without feedback; clears the travel limits, see speed_control_open_loop().
+ *
+ */
+void hal_speed_open_loop(bool direction, uint16_t power);
+
+void hal_speed_stop();
+
+/**
+ * @brief Arms the predictive stop and the hard limit at a position in counts, see speed_control_limit().
+ *
+ */
+void hal_speed_limit(int32_t limit);
+
+void hal_speed_clear_limit();
+
+/**
+ * @brief True while a travel limit holds the motor off.
+ *
+ */
+bool hal_speed_at_limit();
+
+/**
+ * @brief Makes the current position read as 0.
+ *
+ */
+void hal_speed_zero();
+
+/**
+ * @brief Queues a sample for the run log. May drop it when the logger is behind.
+ *
+ */
+void hal_log(log_record_t* rec);
+
+/**
+ * @brief Sends a file or MSC command (log_msg_kind) to the logger.
+ *
+ */
+void hal_send(uint8_t kind);
+
+/**
+ * @brief A cut is about to start: clear the run statistics of the platform.
+ *
+ */
+void hal_run_start();
+
+/**
+ * @brief The run has finished: report the run statistics.
+ *
+ */
+void hal_run_finish();
@@ -0,0 +1,152 @@
+/**
+ * @file core_link.h
+ * @author Thomas Chang
+ * @brief Prototypes for the data path between core 0 (sensors, motor, state machine) and core 1 (SD logging, OLED, USB).
+ * @details Core 0 is the only producer and core 1 the only consumer. Log records and file/MSC commands travel through one
+ * ordered lock-free ring (see spsc_ring.h) so a command can never overtake the records that precede it. The latest
+ * sensor values for the display are published separately through a seqlock, so the display always sees the newest
+ * sample and never stalls the producer. The settings of a run go the same way, for the log header core 1 writes.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "spsc_ring.h"
+#include "fixed_point.h"
+
+#define LOG_RING_DEPTH      512     ///< Records buffered between the cores (16 KB). Must be a power of two.
+
+/**
+ * @brief Message types carried from core 0 to core 1.
+ *
+ */
+enum log_msg_kind {
+    MSG_RECORD,     ///< One data sample for the open log file.
+    MSG_OPEN_LOG,   ///< Create the next data file and write its header.
+    MSG_CLOSE_LOG,  ///< Close the data file and unmount the card.
+    MSG_MSC_ON,     ///< Hand the SD card to the USB host and service TinyUSB.
+    MSG_MSC_OFF     ///< Take the SD card back from the USB host and mount it.
+};
+
+/**
+ * @brief One logged sample or command. Fields are ordered for natural alignment so the record packs into exactly 32
+ * bytes with no compiler padding; 16 records fill one SD sector.
+ * @details Only kind is meaningful for commands. The sensor values are stored as computed, in Q16.16; the run log
+ * header describes them as I32 channels scaled by 2^-16.
+ */
+typedef struct {
+    uint8_t kind;           ///< One of log_msg_kind.
+    uint8_t state;          ///< State machine state when the sample was taken.
+    uint16_t pwm;           ///< PWM level applied by the speed controller.
+    uint32_t time_us;       ///< Ideal release time of the sample, microseconds since boot (wraps after ~71 min).
+    q16_t current_mA;
+    q16_t lp_current;
+    q16_t maf_current;
+    float rpm;
+    q16_t displacement;
+    q16_t force;
+} log_record_t;
+
+static_assert(sizeof(log_record_t) == 32, "log_record_t must stay 32 bytes");
+
+/**
+ * @brief Latest values shown on the OLED. Published by core 0 every control tick.
+ *
+ */
+typedef struct {
+    uint8_t state;
+    q16_t current_mA;
+    float rpm;
+    q16_t displacement;
+    q16_t force;
+    long bat_per;
+    long temp_speed;
+} status_snapshot_t;
+
+/**
+ * @brief Settings of a run, captured on core 0 when the cut starts and written into the log header by core 1.
+ *
+ */
+typedef struct {
+    float fw_rev;
+    float bw_rev;
+    float target_rpm;
+    float stop_coast_ms;    ///< Learned end-of-travel coast time, ms.
+} run_settings_t;
+
+/**
+ * @brief Queues a data sample without blocking. Drops the sample and counts it if the ring is full.
+ *
+ * @param rec The sample. Its kind is set to MSG_RECORD.
+ * @return true if the sample was queued.
+ */
+bool core_link_push_record(log_record_t* rec);
+
+/**
+ * @brief Queues a command. Spins until there is room so commands are never lost.
+ *
+ * @param kind One of log_msg_kind other than MSG_RECORD.
+ */
+void core_link_send(uint8_t kind);
+
+/**
+ * @brief Core 1 only. Borrows the next contiguous run of queued records without copying them.
+ *
+ * @param span Set to the oldest queued record.
+ * @return uint32_t Number of records available in the span.
+ */
+uint32_t core_link_peek(const log_record_t** span);
+
+/**
+ * @brief Core 1 only. Returns records obtained from core_link_peek() to the ring.
+ *
+ * @param count Number of records consumed.
+ */
+void core_link_release(uint32_t count);
+
+/**
+ * @brief Counters of the record ring: high-water mark, drops and records waiting on core 1.
+ *
+ * @return ring_stats_t
+ */
+ring_stats_t core_link_stats();
+
+/**
+ * @brief Core 0 only. Clears the drop and high-water counters at the start of a run.
+ *
+ */
+void core_link_reset_stats();
+
+/**
+ * @brief Publishes the latest display values. Core 0 only.
+ *
+ * @param snap The values to publish.
+ */
+void core_link_publish(const status_snapshot_t* snap);
+
+/**
+ * @brief Reads the most recently published display values.
+ *
+ * @return status_snapshot_t
+ */
+status_snapshot_t core_link_snapshot();
+
+/**
+ * @brief Publishes the settings of the run about to start. Core 0 only; call before sending MSG_OPEN_LOG.
+ *
+ * @param run The settings.
+ */
+void core_link_publish_run(const run_settings_t* run);
+
+/**
+ * @brief Reads the settings of the last run started, e.g. on MSG_OPEN_LOG.
+ *
+ * @return run_settings_t
+ */
+run_settings_t core_link_run();
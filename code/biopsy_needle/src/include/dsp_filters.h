@@ -0,0 +1,362 @@
+/**
+ * @file dsp_filters.h
+ * @author Thomas Chang
+ * @brief Header-only, fixed size sample filters: moving average, one-pole low pass, biquad, running median and a 1-D
+ * Kalman filter, plus FilterChain to run several of them in series.
+ * @details Every filter is a template on its sample type. The arithmetic comes from DspMath<T>, which is specialized
+ * for float, for int32_t raw fixed point values and for the Fixed<F> types of fixed_point.h, so the same filter
+ * compiles to plain float code or to integer multiply/shift code with no run time dispatch. Sizes are template
+ * parameters and all state lives inside the object; nothing is allocated and the cost of update() is fixed (O(1),
+ * except RunningMedian which is O(N)). tools/dsp_test checks the filters and times them on the host.
+ *
+ * Every filter has the same interface, which is what FilterChain relies on:
+ *
+ *     T update(T x);          // Feed one sample, get the filtered value.
+ *     T value() const;        // Last output.
+ *     void reset(T x = 0);    // Forget the history, as if x had been fed forever.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <math.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <tuple>
+#include <type_traits>
+
+#include "fixed_point.h"
+
+/**
+ * @brief Arithmetic of one sample type. Coefficients are given as float and converted once by coef().
+ *
+ * @tparam T Sample type.
+ */
+template <typename T>
+struct DspMath;
+
+template <>
+struct DspMath<float> {
+    typedef float acc_t;    ///< Sums and multiply-accumulate results.
+    typedef float coef_t;   ///< Stored filter coefficient.
+
+    static coef_t coef(float c) { return c; }
+    static float mul(float x, coef_t c) { return x * c; }
+    static acc_t widen(float x) { return x; }
+    static acc_t mac(acc_t acc, float x, coef_t c) { return acc + x * c; }
+    static float narrow(acc_t acc) { return acc; }
+    template <size_t N>
+    static float mean(acc_t sum) { return sum * (1.0f / N); }
+    static coef_t ratio(float num, float den) { return num / den; }
+};
+
+/**
+ * @brief int32_t holds any fixed point format; the filters never need to know where its binary point is.
+ * @details Coefficients are Q2.30, so they cover [-2, 2), which includes every stable biquad. Products are formed in
+ * 64 bits and rounded back.
+ */
+template <>
+struct DspMath<int32_t> {
+    static constexpr int COEF_BITS = 30;
+    typedef int64_t acc_t;
+    typedef int32_t coef_t;
+
+    static coef_t coef(float c) { return (coef_t)lroundf(c * (float)(1L << COEF_BITS)); }
+    static int32_t mul(int32_t x, coef_t c) { return narrow((int64_t)x * c); }
+    static acc_t widen(int32_t x) { return x; }
+    static acc_t mac(acc_t acc, int32_t x, coef_t c) { return acc + (int64_t)x * c; }
+    static int32_t narrow(acc_t acc) { return (int32_t)((acc + (1LL << (COEF_BITS - 1))) >> COEF_BITS); }
+    template <size_t N>
+    static int32_t mean(acc_t sum) { return (int32_t)(sum / (int64_t)N); }
+    static coef_t ratio(int32_t num, int32_t den) { return (coef_t)(((int64_t)num << COEF_BITS) / den); }
+};
+
+/**
+ * @brief Fixed<F> runs on the int32_t arithmetic of its raw value, saturating where the result is narrowed.
+ *
+ */
+template <int F>
+struct DspMath<Fixed<F>> {
+    typedef DspMath<int32_t> R;
+    typedef R::acc_t acc_t;
+    typedef R::coef_t coef_t;
+
+    static coef_t coef(float c) { return R::coef(c); }
+    static Fixed<F> mul(Fixed<F> x, coef_t c) { return narrow((int64_t)x.raw() * c); }
+    static acc_t widen(Fixed<F> x) { return x.raw(); }
+    static acc_t mac(acc_t acc, Fixed<F> x, coef_t c) { return R::mac(acc, x.raw(), c); }
+    static Fixed<F> narrow(acc_t acc) {
+        return Fixed<F>::from_raw(fixed_detail::saturate((acc + (1LL << (R::COEF_BITS - 1))) >> R::COEF_BITS));
+    }
+    template <size_t N>
+    static Fixed<F> mean(acc_t sum) { return Fixed<F>::from_raw((int32_t)(sum / (int64_t)N)); }
+    static coef_t ratio(Fixed<F> num, Fixed<F> den) { return R::ratio(num.raw(), den.raw()); }
+};
+
+/**
+ * @brief Boxcar average of the last N samples, kept as a running sum.
+ * @details Starts from a history of reset() values, so the first N outputs ramp up like the original MAF did.
+ */
+template <typename T, size_t N>
+class MovingAverage {
+    static_assert(N > 0, "MovingAverage needs at least one sample");
+    typedef DspMath<T> M;
+
+public:
+    MovingAverage() { reset(); }
+
+    T update(T x) {
+        _sum += M::widen(x) - M::widen(_buf[_idx]);
+        _buf[_idx] = x;
+        if (++_idx == N) {
+            _idx = 0;
+        }
+        _out = M::template mean<N>(_sum);
+        return _out;
+    }
+
+    T value() const { return _out; }
+
+    void reset(T x = T(0)) {
+        for (size_t i = 0; i < N; i++) {
+            _buf[i] = x;
+        }
+        _sum = M::widen(x) * (typename M::acc_t)N;
+        _idx = 0;
+        _out = x;
+    }
+
+private:
+    T _buf[N];
+    typename M::acc_t _sum;
+    size_t _idx;
+    T _out;
+};
+
+/**
+ * @brief One-pole IIR low pass, y += alpha * (x - y).
+ *
+ */
+template <typename T>
+class OnePole {
+    typedef DspMath<T> M;
+
+public:
+    /**
+     * @param alpha Weight of the new sample, 0 < alpha <= 1. alpha = 1 - exp(-2 pi fc / fs).
+     */
+    explicit OnePole(float alpha) : _alpha(M::coef(alpha)) { reset(); }
+
+    T update(T x) {
+        _y = _y + M::mul(x - _y, _alpha);
+        return _y;
+    }
+
+    T value() const { return _y; }
+
+    void reset(T x = T(0)) { _y = x; }
+
+private:
+    typename M::coef_t _alpha;
+    T _y;
+};
+
+/**
+ * @brief Normalized second order section, y = b0 x + b1 x1 + b2 x2 - a1 y1 - a2 y2.
+ *
+ */
+struct BiquadCoeffs {
+    float b0, b1, b2, a1, a2;
+
+    /// Butterworth style low pass (RBJ cookbook). q = 0.7071 for a maximally flat response.
+    static BiquadCoeffs lowpass(float fs, float fc, float q = 0.70710678f) {
+        float w = 2.0f * (float)M_PI * fc / fs;
+        float alpha = sinf(w) / (2.0f * q);
+        float c = cosf(w);
+        float a0 = 1.0f + alpha;
+        return {(1.0f - c) / 2.0f / a0, (1.0f - c) / a0, (1.0f - c) / 2.0f / a0, -2.0f * c / a0, (1.0f - alpha) / a0};
+    }
+
+    /// Notch at fc with bandwidth fc / q (RBJ cookbook), e.g. for a known mechanical or PWM frequency.
+    static BiquadCoeffs notch(float fs, float fc, float q) {
+        float w = 2.0f * (float)M_PI * fc / fs;
+        float alpha = sinf(w) / (2.0f * q);
+        float c = cosf(w);
+        float a0 = 1.0f + alpha;
+        return {1.0f / a0, -2.0f * c / a0, 1.0f / a0, -2.0f * c / a0, (1.0f - alpha) / a0};
+    }
+};
+
+/**
+ * @brief Biquad in direct form I. DF I keeps the feedback sum in the wide accumulator, which is what makes the
+ * fixed point version well behaved.
+ *
+ */
+template <typename T>
+class Biquad {
+    typedef DspMath<T> M;
+
+public:
+    explicit Biquad(const BiquadCoeffs& c)
+        : _b0(M::coef(c.b0)), _b1(M::coef(c.b1)), _b2(M::coef(c.b2)), _a1(M::coef(-c.a1)), _a2(M::coef(-c.a2)) {
+        reset();
+    }
+
+    T update(T x) {
+        typename M::acc_t acc = 0;
+        acc = M::mac(acc, x, _b0);
+        acc = M::mac(acc, _x1, _b1);
+        acc = M::mac(acc, _x2, _b2);
+        acc = M::mac(acc, _y1, _a1);
+        acc = M::mac(acc, _y2, _a2);
+        T y = M::narrow(acc);
+        _x2 = _x1;
+        _x1 = x;
+        _y2 = _y1;
+        _y1 = y;
+        return y;
+    }
+
+    T value() const { return _y1; }
+
+    /// Settles the section on a constant input x (unity DC gain assumed, as for the low pass).
+    void reset(T x = T(0)) {
+        _x1 = _x2 = x;
+        _y1 = _y2 = x;
+    }
+
+private:
+    typename M::coef_t _b0, _b1, _b2, _a1, _a2;   ///< a1/a2 stored negated so every term is a multiply-accumulate.
+    T _x1, _x2, _y1, _y2;
+};
+
+/**
+ * @brief Median of the last N samples. Removes single sample spikes without smearing steps like an average does.
+ * @details A sorted copy of the window is kept up to date by one remove and one insert, O(N) per sample. Meant for
+ * small N (3 to 15).
+ */
+template <typename T, size_t N>
+class RunningMedian {
+    static_assert(N % 2 == 1, "RunningMedian needs an odd window");
+
+public:
+    RunningMedian() { reset(); }
+
+    T update(T x) {
+        T old = _hist[_idx];
+        _hist[_idx] = x;
+        if (++_idx == N) {
+            _idx = 0;
+        }
+
+        // Drop the oldest sample from the sorted window...
+        size_t i = 0;
+        while (i + 1 < N && _sorted[i] != old) {
+            i++;
+        }
+        for (; i + 1 < N; i++) {
+            _sorted[i] = _sorted[i + 1];
+        }
+        // ...and insert the new one in order.
+        i = N - 1;
+        while (i > 0 && _sorted[i - 1] > x) {
+            _sorted[i] = _sorted[i - 1];
+            i--;
+        }
+        _sorted[i] = x;
+        return _sorted[N / 2];
+    }
+
+    T value() const { return _sorted[N / 2]; }
+
+    void reset(T x = T(0)) {
+        for (size_t i = 0; i < N; i++) {
+            _hist[i] = x;
+            _sorted[i] = x;
+        }
+        _idx = 0;
+    }
+
+private:
+    T _hist[N];     ///< Samples in arrival order (ring).
+    T _sorted[N];   ///< The same samples, ascending.
+    size_t _idx;
+};
+
+/**
+ * @brief Scalar Kalman filter for a slowly wandering value (random walk) seen through white measurement noise.
+ * @details Float only: the covariance spans many orders of magnitude while it converges, which a 32 bit fixed point
+ * format cannot hold. With constant q and r the gain settles to a constant, so once converged it behaves like a
+ * OnePole with alpha = gain() that tuned itself from the noise figures.
+ */
+template <typename T>
+class Kalman1D {
+    static_assert(std::is_floating_point<T>::value, "Kalman1D is only provided for floating point samples");
+
+public:
+    /**
+     * @param q Process noise variance per sample (how far the true value may move between samples).
+     * @param r Measurement noise variance.
+     * @param p0 Initial estimate variance after reset().
+     */
+    Kalman1D(T q, T r, T p0 = T(1)) : _q(q), _r(r), _p0(p0) { reset(); }
+
+    T update(T z) {
+        _p += _q;
+        _k = _p / (_p + _r);
+        _x += _k * (z - _x);
+        _p *= (T(1) - _k);
+        return _x;
+    }
+
+    T value() const { return _x; }
+
+    /// Current gain, i.e. the weight given to the newest measurement.
+    T gain() const { return _k; }
+
+    void reset(T x = T(0)) {
+        _x = x;
+        _p = _p0;
+        _k = T(1);
+    }
+
+private:
+    T _q, _r, _p0;
+    T _x, _p, _k;
+};
+
+/**
+ * @brief Runs filters in series: the output of each stage is the input of the next. Stages are stored by value.
+ *
+ *     FilterChain<float, RunningMedian<float, 3>, OnePole<float>> force{{}, OnePole<float>(0.3f)};
+ */
+template <typename T, typename... Stages>
+class FilterChain {
+public:
+    explicit FilterChain(Stages... stages) : _stages(stages...) {}
+
+    T update(T x) {
+        std::apply([&x](auto&... s) { ((x = s.update(x)), ...); }, _stages);
+        _out = x;
+        return x;
+    }
+
+    T value() const { return _out; }
+
+    void reset(T x = T(0)) {
+        std::apply([x](auto&... s) { (s.reset(x), ...); }, _stages);
+        _out = x;
+    }
+
+    /// Access to one stage, e.g. to read a Kalman gain.
+    template <size_t I>
+    auto& stage() { return std::get<I>(_stages); }
+
+private:
+    std::tuple<Stages...> _stages;
+    T _out = T(0);
+};
@@ -0,0 +1,188 @@
+/**
+ * @file fixed_point.h
+ * @author Thomas Chang
+ * @brief Signed 32 bit Q-format fixed point numbers and compile time linear unit conversions.
+ * @details The M0+ has no FPU, so every float multiply or int/float conversion in the sample path is a library call.
+ * Fixed<F> keeps a value as an int32_t with F fractional bits and does all arithmetic in integers. Addition,
+ * subtraction and multiplication saturate at the ends of the range instead of wrapping, so a wild sensor value clips
+ * rather than flipping sign.
+ *
+ * LinearMap turns a raw reading into physical units (y = k * x + b). k and b are given as doubles, but the constructor
+ * is constexpr, so a map declared constexpr folds them into one integer multiplier, one shift and one offset with the
+ * best precision that fits, and no floating point code is emitted at all.
+ *
+ *     constexpr LinearMap<16> counts_to_N(0.00794, -7.94);
+ *     q16_t force = counts_to_N(raw);                      // one 32x32->64 multiply, a shift and an add
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+namespace fixed_detail {
+
+constexpr int32_t saturate(int64_t v) {
+    return v > INT32_MAX ? INT32_MAX : (v < INT32_MIN ? INT32_MIN : (int32_t)v);
+}
+
+/// 2^e for any integer e, usable in constant expressions.
+constexpr double pow2(int e) {
+    double r = 1.0;
+    for (; e > 0; e--) {
+        r *= 2.0;
+    }
+    for (; e < 0; e++) {
+        r *= 0.5;
+    }
+    return r;
+}
+
+/// Round half away from zero, usable in constant expressions.
+constexpr int64_t round_to_int(double v) {
+    return (int64_t)(v >= 0.0 ? v + 0.5 : v - 0.5);
+}
+
+}  // namespace fixed_detail
+
+/**
+ * @brief Fixed point number with F fractional bits (Q(31-F).F).
+ *
+ * @tparam F Fractional bits, 0 to 31.
+ */
+template <int F>
+class Fixed {
+    static_assert(F >= 0 && F <= 31, "Fixed needs 0 to 31 fractional bits");
+
+public:
+    static constexpr int FRAC = F;
+
+    constexpr Fixed() : _raw(0) {}
+
+    /// Integer value v (not a raw value).
+    constexpr explicit Fixed(int v) : _raw(fixed_detail::saturate((int64_t)v * ((int64_t)1 << F))) {}
+
+    static constexpr Fixed from_raw(int32_t raw) {
+        Fixed f;
+        f._raw = raw;
+        return f;
+    }
+
+    /// Meant for constants; only free of float code when evaluated at compile time.
+    static constexpr Fixed from_double(double v) {
+        return from_raw(fixed_detail::saturate(fixed_detail::round_to_int(v * fixed_detail::pow2(F))));
+    }
+
+    constexpr int32_t raw() const { return _raw; }
+
+    /// Largest integer not above the value.
+    constexpr int32_t to_int() const { return _raw >> F; }
+
+    /// Nearest integer, halves rounded up.
+    constexpr int32_t round() const { return (int32_t)(((int64_t)_raw + (F ? ((int64_t)1 << (F - 1)) : 0)) >> F); }
+
+    /// For display and logging on the slow path only.
+    float to_float() const { return (float)_raw * (float)(1.0 / fixed_detail::pow2(F)); }
+
+    /// The same value with G fractional bits (rounded when bits are dropped, saturated when it does not fit).
+    template <int G>
+    constexpr Fixed<G> convert() const {
+        if constexpr (G >= F) {
+            return Fixed<G>::from_raw(fixed_detail::saturate((int64_t)_raw * ((int64_t)1 << (G - F))));
+        } else {
+            return Fixed<G>::from_raw((int32_t)(((int64_t)_raw + ((int64_t)1 << (F - G - 1))) >> (F - G)));
+        }
+    }
+
+    static constexpr Fixed max() { return from_raw(INT32_MAX); }
+    static constexpr Fixed min() { return from_raw(INT32_MIN); }
+
+    constexpr Fixed operator+(Fixed o) const { return from_raw(fixed_detail::saturate((int64_t)_raw + o._raw)); }
+    constexpr Fixed operator-(Fixed o) const { return from_raw(fixed_detail::saturate((int64_t)_raw - o._raw)); }
+    constexpr Fixed operator-() const { return from_raw(fixed_detail::saturate(-(int64_t)_raw)); }
+
+    /// Product rounded to F fractional bits.
+    constexpr Fixed operator*(Fixed o) const {
+        int64_t p = (int64_t)_raw * o._raw;
+        if constexpr (F > 0) {
+            p = (p + ((int64_t)1 << (F - 1))) >> F;
+        }
+        return from_raw(fixed_detail::saturate(p));
+    }
+
+    constexpr Fixed operator*(int32_t k) const { return from_raw(fixed_detail::saturate((int64_t)_raw * k)); }
+
+    /// Division by an integer, truncated toward zero. k must not be 0.
+    constexpr Fixed operator/(int32_t k) const { return from_raw(_raw / k); }
+
+    Fixed& operator+=(Fixed o) { return *this = *this + o; }
+    Fixed& operator-=(Fixed o) { return *this = *this - o; }
+    Fixed& operator*=(Fixed o) { return *this = *this * o; }
+
+    constexpr bool operator==(Fixed o) const { return _raw == o._raw; }
+    constexpr bool operator!=(Fixed o) const { return _raw != o._raw; }
+    constexpr bool operator<(Fixed o) const { return _raw < o._raw; }
+    constexpr bool operator>(Fixed o) const { return _raw > o._raw; }
+    constexpr bool operator<=(Fixed o) const { return _raw <= o._raw; }
+    constexpr bool operator>=(Fixed o) const { return _raw >= o._raw; }
+
+private:
+    int32_t _raw;
+};
+
+typedef Fixed<16> q16_t;    ///< Q16.16: +-32768 with 1.5e-5 resolution. Physical values (mA, N, mm, %).
+typedef Fixed<31> q31_t;    ///< Q1.31: [-1, 1) with 4.7e-10 resolution. Ratios and gains.
+
+/// Clamps v to [lo, hi].
+template <int F>
+constexpr Fixed<F> fixed_clamp(Fixed<F> v, Fixed<F> lo, Fixed<F> hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+/**
+ * @brief y = k * x + b from a raw Q(IN_F) input to a Q(OUT_F) result, with k and b folded at compile time.
+ * @details The constructor picks the largest shift that keeps the integer multiplier inside 32 bits, so small factors
+ * such as 0.5 mm per 1633 counts keep full precision. Results saturate.
+ *
+ * @tparam OUT_F Fractional bits of the result.
+ * @tparam IN_F Fractional bits of the input; 0 for plain integer readings.
+ */
+template <int OUT_F, int IN_F = 0>
+class LinearMap {
+public:
+    constexpr LinearMap(double k, double b) : _mul(0), _shift(0), _offset(0) {
+        double m = k * fixed_detail::pow2(OUT_F - IN_F);
+        double mag = m < 0.0 ? -m : m;
+        int shift = 0;
+        if (mag > 0.0) {
+            while (shift < 62 && mag * fixed_detail::pow2(shift + 1) < 2147483647.0) {
+                shift++;
+            }
+            while (shift > 0 && mag * fixed_detail::pow2(shift) >= 2147483647.0) {
+                shift--;
+            }
+        }
+        _mul = (int32_t)fixed_detail::round_to_int(m * fixed_detail::pow2(shift));
+        _shift = shift;
+        _offset = fixed_detail::round_to_int(b * fixed_detail::pow2(OUT_F));
+    }
+
+    constexpr Fixed<OUT_F> operator()(int32_t raw) const {
+        int64_t p = (int64_t)raw * _mul;
+        if (_shift > 0) {
+            p = (p + ((int64_t)1 << (_shift - 1))) >> _shift;
+        }
+        return Fixed<OUT_F>::from_raw(fixed_detail::saturate(p + _offset));
+    }
+
+    constexpr Fixed<OUT_F> operator()(Fixed<IN_F> x) const { return (*this)(x.raw()); }
+
+private:
+    int32_t _mul;
+    int _shift;
+    int64_t _offset;
+};
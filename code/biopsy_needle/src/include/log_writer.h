@@ -0,0 +1,71 @@
+/**
+ * @file log_writer.h
+ * @author Thomas Chang
+ * @brief Prototypes for the SD run log writer. Core 1 only.
+ * @details At the start of a run the file is preallocated as one contiguous extent with f_expand and a fast seek
+ * cluster map is built for it, so FatFS never touches the FAT while samples are written. Data is collected in a
+ * sector-aligned chunk and handed to f_write LOG_CHUNK_SECTORS at a time, which FatFS passes straight to the card as a
+ * single multi-block (CMD25) write. Consecutive chunks land on consecutive sectors, so the SPI driver keeps the same
+ * CMD25 transfer open across chunks. On close the file is truncated to the bytes actually written.
+ *
+ * The chunk is the only buffer on the writer side. While a chunk is being written, new samples keep accumulating in
+ * the inter-core ring (core_link.h), which acts as the second half of the double buffer.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "ff.h"
+#include <stdint.h>
+
+#define LOG_CHUNK_SECTORS   8                                   ///< Sectors per f_write (4 KB, ~0.25 s of samples).
+#define LOG_CHUNK_BYTES     (LOG_CHUNK_SECTORS * 512)
+#define LOG_PREALLOC_BYTES  (8u * 1024 * 1024)                  ///< Contiguous space reserved per run (~8 min at 500 Hz).
+
+/**
+ * @brief Counters for one run, reported when the file is closed.
+ *
+ */
+typedef struct {
+    uint32_t bytes;             ///< Bytes accepted by log_writer_write().
+    uint32_t chunks;            ///< Calls to f_write.
+    uint32_t max_write_us;      ///< Longest single f_write.
+    uint32_t total_write_us;    ///< Time spent in f_write.
+    uint32_t errors;            ///< Failed or short writes.
+    bool contiguous;            ///< The preallocation succeeded.
+} log_writer_stats_t;
+
+/**
+ * @brief Attaches the writer to a freshly created, empty file and preallocates LOG_PREALLOC_BYTES for it.
+ * @details If there is no contiguous free space the run is still logged, just without preallocation.
+ * @param fil File opened for writing with size 0.
+ * @return FRESULT Result of f_expand. Anything but FR_OK means the file grows cluster by cluster.
+ */
+FRESULT log_writer_open(FIL* fil);
+
+/**
+ * @brief Appends bytes to the log. Only touches the card when a whole chunk is full.
+ *
+ * @param data Bytes to append.
+ * @param len Number of bytes.
+ * @return false if a chunk could not be written completely.
+ */
+bool log_writer_write(const void* data, uint32_t len);
+
+/**
+ * @brief Writes the partial last chunk and truncates the file to its real length. The caller still closes the file.
+ *
+ * @return FRESULT
+ */
+FRESULT log_writer_close();
+
+/**
+ * @brief Counters of the current or last run.
+ *
+ * @return log_writer_stats_t
+ */
+log_writer_stats_t log_writer_stats();
@@ -0,0 +1,86 @@
+/**
+ * @file motion_profile.h
+ * @author Thomas Chang
+ * @brief Prototypes for the jerk limited (S-curve) motion profile that moves the needle to a target position.
+ * @details The profile is generated online, one speed setpoint per control tick, for the speed controller to follow.
+ * Each tick it picks a goal speed: the cruise speed, or the speed from which the needle can still brake to the
+ * target at cfg.accel, whichever is lower. The braking speed is computed from the measured remaining distance, so
+ * tracking errors of the speed loop are corrected on the way and the move ends on the target instead of past it.
+ * The setpoint then approaches the goal with the acceleration ramped at cfg.jerk, which rounds every corner of the
+ * trapezoid into an S-curve:
+ *
+ *     a_goal = sign(v_goal - v) * min(accel, sqrt(2 * jerk * |v_goal - v|))
+ *
+ * The last stretch is covered at cfg.min_rpm at least, so friction cannot stall the needle just short of the target.
+ * The move is done once the needle is within cfg.tol_rev of the target.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Limits of the profile. See config.h for the defaults.
+ *
+ */
+typedef struct {
+    float accel;        ///< Largest acceleration, RPM/s.
+    float jerk;         ///< Largest change of acceleration, RPM/s^2.
+    float min_rpm;      ///< Slowest setpoint before the target is reached.
+    float tol_rev;      ///< Distance to the target that counts as arrived, output revolutions.
+} motion_profile_config_t;
+
+/**
+ * @brief State of one move. Speeds and positions are kept in output revolutions (per second).
+ *
+ */
+typedef struct {
+    motion_profile_config_t cfg;
+    bool active;
+    bool forward;       ///< Direction of the move.
+    float target;       ///< Target position, revolutions.
+    float v_max;        ///< Cruise speed, rev/s.
+    float v;            ///< Setpoint, rev/s.
+    float a;            ///< Setpoint acceleration, rev/s^2.
+} motion_profile_t;
+
+void motion_profile_init(motion_profile_t* p, const motion_profile_config_t* cfg);
+
+/**
+ * @brief Starts a move from standstill.
+ *
+ * @param p Profile.
+ * @param from_rev Current position.
+ * @param to_rev Target position.
+ * @param max_rpm Cruise speed.
+ */
+void motion_profile_start(motion_profile_t* p, float from_rev, float to_rev, float max_rpm);
+
+/**
+ * @brief Advances the profile by one tick.
+ *
+ * @param p Profile.
+ * @param pos_rev Measured position.
+ * @param dt Tick length in seconds.
+ * @return float Speed setpoint in RPM in the move's direction; 0 once done.
+ */
+float motion_profile_update(motion_profile_t* p, float pos_rev, float dt);
+
+/**
+ * @brief Ends the move at once (setpoint 0).
+ *
+ */
+void motion_profile_stop(motion_profile_t* p);
+
+/**
+ * @brief True once the move has arrived or was stopped.
+ *
+ */
+static inline bool motion_profile_done(const motion_profile_t* p) {
+    return !p->active;
+}
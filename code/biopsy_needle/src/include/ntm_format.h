@@ -0,0 +1,81 @@
+/**
+ * @file ntm_format.h
+ * @author Thomas Chang
+ * @brief Prototypes for the allocation-free text formatter used by the OLED widgets and the CSV log.
+ * @details Text is appended to a caller supplied buffer through an fmt_t cursor. The buffer is always NUL terminated
+ * and output that does not fit is dropped, so no call can overrun it. Fixed point output splits the float into its
+ * exact integer and fraction parts and prints them with integer arithmetic, which is far cheaper than std::to_string
+ * or printf on the M0+ and never touches the heap.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define FMT_MAX_DECIMALS    9
+
+/**
+ * @brief Write cursor into a caller supplied buffer.
+ *
+ */
+typedef struct {
+    char* buf;      ///< Destination, always NUL terminated.
+    size_t cap;     ///< Size of buf including the terminator.
+    size_t len;     ///< Characters written so far.
+} fmt_t;
+
+/**
+ * @brief Starts formatting into buf.
+ *
+ * @param f Cursor to initialize.
+ * @param buf Destination buffer.
+ * @param cap Size of buf in bytes. Must be at least 1.
+ */
+void fmt_init(fmt_t* f, char* buf, size_t cap);
+
+/**
+ * @brief Appends one character.
+ *
+ */
+void fmt_char(fmt_t* f, char c);
+
+/**
+ * @brief Appends a NUL terminated string.
+ *
+ */
+void fmt_str(fmt_t* f, const char* s);
+
+/**
+ * @brief Appends an unsigned integer.
+ *
+ * @param v Value.
+ * @param width Minimum field width. Shorter numbers are padded on the left.
+ * @param pad Padding character, e.g. ' ' or '0'.
+ */
+void fmt_uint(fmt_t* f, uint32_t v, uint8_t width = 0, char pad = ' ');
+
+/**
+ * @brief Appends a signed integer.
+ *
+ * @param v Value.
+ * @param width Minimum field width including the sign.
+ * @param pad Padding character. With '0' the sign comes before the zeros.
+ */
+void fmt_int(fmt_t* f, int32_t v, uint8_t width = 0, char pad = ' ');
+
+/**
+ * @brief Appends a number with a fixed count of decimals, like printf("%.*f") but with exact ties rounded away from
+ * zero instead of to even.
+ * @details Prints "nan" for NaN and "ovf" when the magnitude does not fit in 32 bits. A result that rounds to zero
+ * is printed without a sign. tools/format_test checks the output against printf.
+ * @param v Value.
+ * @param decimals Digits after the point, at most FMT_MAX_DECIMALS. 0 prints no point.
+ * @param width Minimum field width, padded with spaces on the left.
+ */
+void fmt_fixed(fmt_t* f, float v, uint8_t decimals, uint8_t width = 0);
@@ -13,13 +13,14 @@
 
 #include "pins.h"
 #include "config.h"
+#include "fixed_point.h"
 
-#include <iostream>
-#include <string>
 #include <stdio.h>
 
 // Peripherals
 #include "../../libs/SSD1306/ssd1306.h"
+#include "../../libs/I2C_DMA/i2c_dma.h"
+#include "../../libs/QUAD_ENC/quad_encoder.h"
 
 // Includes for the FatFS Library
 #include "pico/stdlib.h"
@@ -36,17 +37,25 @@
 /**
  * @brief Initiates all GPIO pins as well as communication protocols.
  * 
+ * @return false if the encoder state machines could not be set up (no free state machine or program space).
  */
-void board_gpio_init();
+bool board_gpio_init();
 
 /**
  * @brief Turns on motor with configureable speed and direction values.
  * 
  * @param direction Integer value where 1 means forward and 0 means backward.
  * @param power Integer value representing power of the motor ranging from 0-255 where 255 is the maximum.
+ * The command is kept in motorDir and motorPower for the stall detector.
  */
 void setMotor(bool direction, uint16_t power);
 
+/**
+ * @brief Sets the motor PWM to 0 keeping the direction. Runs from RAM, so it may be called from any interrupt.
+ *
+ */
+void motorOff();
+
 /**
  * @brief Helper function used to abstract how sensor data is shown on the OLED screen
  * 
@@ -54,15 +63,7 @@ void setMotor(bool direction, uint16_t power);
  * @param y_pos The y position in pixels (bottom left) of where the text is written.
  * @param data The actual sensor information.
  * @param info Any string messages detailing what the sensor information is measuring.
+ * @param decimals Digits shown after the decimal point.
  */
-void displayData(ssd1306_t* screen, int y_pos, float data, std::string info);
-
-/**
- * @brief Takes detected motor signals and converts them to the real-world number of revolutions of the motor shaft. 
- * 
- * @details The conversion is as follows: number_of_counts * (1 small revolution / 12 counts) * (1 big revolution / 34.014 small revolutions). 34.014 is the gear ratio whilst the (small revolutions / counts) is from the motor documentation.
- * @param count Number of signal edges recieved from motor (see quadrature encoder information in motor documentation).
- * @return float 
- */
-float getRevolutions(int count);
+void displayData(ssd1306_t* screen, int y_pos, float data, const char* info, uint8_t decimals = 2);
 
@@ -54,3 +54,14 @@
     #error "Unsupported PLATFORM value"
 #endif
 
+/// The quadrature decoder reads both encoder channels from consecutive pins starting at ENCODER_PIN_BASE.
+#define ENCODER_PIO      pio0
+#define ENCODER_TIME_PIO pio1       ///< Edge period measurement on motorA_out for the velocity estimate.
+#define ENCODER_LIMIT_PIO pio1      ///< Hard travel limit on motorA_out; pio0 has no room left behind the decoder.
+#define ENCODER_PIN_BASE motorB_out
+static_assert(motorA_out == motorB_out + 1, "encoder channels must be on consecutive pins");
+
+/// ADC input numbers of the analog pins (input n is GPIO 26 + n).
+#define BAT_ADC_INPUT   (bat_lvl - 26)
+#define SPEED_ADC_INPUT (speed_input - 26)
+
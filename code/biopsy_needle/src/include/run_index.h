@@ -0,0 +1,44 @@
+/**
+ * @file run_index.h
+ * @author Thomas Chang
+ * @brief Prototypes for allocating run log files. Core 1 only.
+ * @details The number of the next run is kept in RUN_INDEX_FILE at the root of the card, so a new log is opened
+ * without searching for a free name. Logs are grouped RUNS_PER_DIR to a directory (runs000/data0.bin ...
+ * runs000/data99.bin, runs001/data100.bin, ...) so no directory FatFS has to scan grows with the number of runs.
+ *
+ * The counter lives on the card rather than in flash so it follows the card between devices and erasing it never
+ * stalls code running from flash on core 0.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "ff.h"
+#include <stddef.h>
+#include <stdint.h>
+
+#define RUN_INDEX_FILE      "runs.idx"
+#define RUNS_PER_DIR        100
+#define RUN_INDEX_MAX_SKIP  1000        ///< Existing logs stepped over before giving up with FR_EXIST.
+
+/**
+ * @brief Reserves the next run number and creates its log file.
+ * @details The counter is advanced before the log is created, so a run that is interrupted never has its number
+ * reused. If the index is missing, damaged or cannot be written, numbering continues from the number read (0 if
+ * none) and up to RUN_INDEX_MAX_SKIP existing files are skipped.
+ * @param fil File object, opened for writing on success.
+ * @param ext File extension without the dot.
+ * @param run Set to the run number.
+ * @param path Set to the path of the new file.
+ * @param path_len Size of path.
+ * @param index_fr Set to the FRESULT of updating RUN_INDEX_FILE. The log can still be created when this fails, but
+ * the next run will have to skip over it.
+ * @return FRESULT of creating the log file, FR_EXIST if RUN_INDEX_MAX_SKIP files were skipped without finding a free
+ * number.
+ */
+FRESULT run_index_open_next(FIL* fil, const char* ext, uint32_t* run, char* path, size_t path_len,
+                            FRESULT* index_fr);
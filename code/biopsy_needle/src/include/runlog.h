@@ -0,0 +1,45 @@
+/**
+ * @file runlog.h
+ * @author Thomas Chang
+ * @brief Prototypes for writing the binary run log header. See runlog_format.h for the on-disk layout.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include "runlog_format.h"
+
+#define RUNLOG_RECORD_CHANNELS  9   ///< Columns of log_record_t described in every header.
+
+/// Bytes runlog_build_header() produces for param_count parameters, for sizing its buffer at compile time.
+#define RUNLOG_HEADER_BYTES(param_count)                                                                            \
+    ((sizeof(runlog_header_t) + RUNLOG_RECORD_CHANNELS * sizeof(runlog_channel_t) +                                  \
+      (param_count) * sizeof(runlog_param_t) + RUNLOG_ALIGN - 1) / RUNLOG_ALIGN * RUNLOG_ALIGN)
+
+/**
+ * @brief Everything about a run that goes into the log header besides the fixed record schema.
+ *
+ */
+typedef struct {
+    uint16_t run_number;                ///< Sequence number of the run.
+    uint32_t sample_rate_hz;            ///< Nominal record rate.
+    const char* const* state_names;     ///< Names of the state machine states, indexed by state value.
+    uint8_t state_count;                ///< Entries in state_names (at most RUNLOG_MAX_STATES).
+    const runlog_param_t* params;       ///< Constants the run is recorded with.
+    uint16_t param_count;               ///< Entries in params.
+} runlog_info_t;
+
+/**
+ * @brief Serializes the header, channel table and parameter table for log_record_t records into buf.
+ * @details The result is zero padded up to a multiple of RUNLOG_ALIGN so the first record starts on a sector.
+ * @param buf Destination buffer.
+ * @param cap Size of buf in bytes.
+ * @param info Run description.
+ * @return size_t Number of bytes to write (the header_size field), or 0 if buf is too small.
+ */
+size_t runlog_build_header(uint8_t* buf, size_t cap, const runlog_info_t* info);
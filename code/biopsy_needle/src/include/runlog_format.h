@@ -0,0 +1,103 @@
+/**
+ * @file runlog_format.h
+ * @author Thomas Chang
+ * @brief On-disk layout of the binary run log. Shared by the firmware and the host converter (tools/runlog_convert).
+ * @details A run log is a header followed by fixed-size records. Everything is little-endian.
+ *
+ *     [runlog_header_t][channel_count x runlog_channel_t][param_count x runlog_param_t][zero padding]
+ *     [record 0][record 1]...
+ *
+ * header_size is the offset of the first record and is always a multiple of RUNLOG_ALIGN, so records never straddle an
+ * SD sector. The channel table describes where each value lives inside a record, its type and unit, so the converter
+ * does not need to be rebuilt when a channel is added. The parameter table stores the constants the run was taken with
+ * (travel limits, filter constants, rates). Readers must skip unknown channel types and ignore unknown parameters.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#define RUNLOG_MAGIC        "NTMRLOG"   ///< 7 characters plus the terminator fill runlog_header_t::magic.
+#define RUNLOG_VERSION      1
+#define RUNLOG_ALIGN        512         ///< header_size is rounded up to this so records start on a sector.
+#define RUNLOG_NAME_LEN     16
+#define RUNLOG_UNIT_LEN     8
+#define RUNLOG_REV_LEN      24
+#define RUNLOG_MAX_STATES   8
+#define RUNLOG_STATE_LEN    12
+
+/**
+ * @brief Storage type of a channel inside a record. The physical value is raw * scale.
+ *
+ */
+enum runlog_type {
+    RUNLOG_U8  = 1,
+    RUNLOG_U16 = 2,
+    RUNLOG_U32 = 3,
+    RUNLOG_I16 = 4,
+    RUNLOG_I32 = 5,
+    RUNLOG_F32 = 6
+};
+
+/**
+ * @brief Special meaning of a channel, so readers can rebuild the legacy CSV without relying on names.
+ *
+ */
+enum runlog_role {
+    RUNLOG_ROLE_DATA    = 0,    ///< Ordinary sample value.
+    RUNLOG_ROLE_STATE   = 1,    ///< Index into runlog_header_t::state_names.
+    RUNLOG_ROLE_TIME_US = 2     ///< Wrapping 32 bit microsecond timestamp.
+};
+
+#pragma pack(push, 1)
+
+/**
+ * @brief Fixed part of the header.
+ *
+ */
+typedef struct {
+    char magic[8];                                          ///< RUNLOG_MAGIC, NUL terminated.
+    uint16_t version;                                       ///< RUNLOG_VERSION of the writer.
+    uint16_t header_size;                                   ///< Offset of the first record in bytes.
+    uint16_t record_size;                                   ///< Size of one record in bytes.
+    uint16_t channel_count;                                 ///< Entries in the channel table.
+    uint16_t param_count;                                   ///< Entries in the parameter table.
+    uint16_t run_number;                                    ///< Sequence number of the run on this card.
+    uint32_t sample_rate_hz;                                ///< Nominal record rate.
+    char firmware_rev[RUNLOG_REV_LEN];                      ///< Firmware version and source revision.
+    char state_names[RUNLOG_MAX_STATES][RUNLOG_STATE_LEN];  ///< Names for RUNLOG_ROLE_STATE values.
+} runlog_header_t;
+
+/**
+ * @brief Describes one value stored in every record.
+ *
+ */
+typedef struct {
+    char name[RUNLOG_NAME_LEN];     ///< Column title without unit, e.g. "Current".
+    char unit[RUNLOG_UNIT_LEN];     ///< Unit, e.g. "mA". Empty if dimensionless.
+    uint8_t type;                   ///< runlog_type.
+    uint8_t offset;                 ///< Byte offset inside the record.
+    uint8_t role;                   ///< runlog_role.
+    uint8_t reserved;
+    float scale;                    ///< Physical value = raw * scale.
+} runlog_channel_t;
+
+/**
+ * @brief A named constant the run was recorded with.
+ *
+ */
+typedef struct {
+    char name[RUNLOG_NAME_LEN];
+    float value;
+} runlog_param_t;
+
+#pragma pack(pop)
+
+static_assert(sizeof(runlog_header_t) == 144, "runlog_header_t layout changed");
+static_assert(sizeof(runlog_channel_t) == 32, "runlog_channel_t layout changed");
+static_assert(sizeof(runlog_param_t) == 20, "runlog_param_t layout changed");
@@ -0,0 +1,93 @@
+/**
+ * @file scheduler.h
+ * @author Thomas Chang
+ * @brief Prototypes for the timer-driven rate-group scheduler that paces the control loop.
+ * @details A single repeating timer on a dedicated hardware alarm ticks at SCHED_BASE_HZ. Every tick it releases the
+ * tasks whose rate group is due by marking them pending and stamping their ideal release time. The main loop then runs
+ * pending tasks in rate-monotonic order (fastest group first), so blocking I2C or display work never runs in interrupt
+ * context but the release instants stay locked to the hardware timer.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "pico/stdlib.h"
+
+#define SCHED_BASE_HZ       1000    ///< Base tick rate of the scheduler. Every rate group must divide this evenly.
+#define SCHED_MAX_TASKS     8       ///< Maximum number of tasks that can be registered.
+
+/**
+ * @brief Function signature for a scheduled task.
+ *
+ * @param release_us The ideal release time of this invocation in microseconds since boot. Use this as the sample
+ * timestamp so logs are uniformly spaced regardless of when the task actually started.
+ */
+typedef void (*sched_task_fn)(uint64_t release_us);
+
+/**
+ * @brief Bookkeeping and timing statistics for one scheduled task.
+ *
+ */
+typedef struct {
+    const char* name;               ///< Human readable name used in statistics output.
+    sched_task_fn fn;               ///< Task body.
+    uint32_t divider;               ///< Task runs every divider base ticks.
+    uint32_t phase;                 ///< Base tick offset inside the period, spreads groups across ticks.
+    volatile bool pending;          ///< Set by the timer when released, cleared when the task starts.
+    volatile uint64_t release_us;   ///< Ideal release time of the pending invocation.
+
+    uint32_t runs;                  ///< Number of completed invocations.
+    uint32_t overruns;              ///< Releases that found the previous invocation still pending.
+    uint32_t last_jitter_us;        ///< Start time minus ideal release time of the last invocation.
+    uint32_t max_jitter_us;         ///< Worst start latency seen since the last reset.
+    uint32_t last_exec_us;          ///< Execution time of the last invocation.
+    uint32_t max_exec_us;           ///< Worst execution time seen since the last reset.
+} sched_task_t;
+
+/**
+ * @brief Registers a task in a rate group. Must be called before scheduler_start().
+ *
+ * @param name Name used in statistics output.
+ * @param rate_hz Rate of the group in Hz. Must divide SCHED_BASE_HZ.
+ * @param fn Task body.
+ * @return int Task id, or -1 if the task table is full or the rate is invalid.
+ */
+int scheduler_add_task(const char* name, uint32_t rate_hz, sched_task_fn fn);
+
+/**
+ * @brief Claims a free hardware alarm and starts the base tick.
+ *
+ * @return true if the repeating timer was armed.
+ */
+bool scheduler_start();
+
+/**
+ * @brief Runs every released task once, highest rate group first. Call continuously from the main loop.
+ *
+ * @return int Number of tasks executed during this call.
+ */
+int scheduler_run_pending();
+
+/**
+ * @brief Returns the statistics block for a task.
+ *
+ * @param id Task id returned by scheduler_add_task().
+ * @return const sched_task_t* or NULL if the id is invalid.
+ */
+const sched_task_t* scheduler_get_task(int id);
+
+/**
+ * @brief Clears the jitter, execution time and overrun counters of every task.
+ *
+ */
+void scheduler_reset_stats();
+
+/**
+ * @brief Prints a per task table of run count, overruns, jitter and execution time over stdio.
+ *
+ */
+void scheduler_print_stats();
@@ -0,0 +1,35 @@
+/**
+ * @file sensor_units.h
+ * @author Thomas Chang
+ * @brief Raw sensor readings to physical units, as Q16.16 conversions (see fixed_point.h).
+ * @details The one definition of each conversion. Free of the SDK, so the host tools (host_sim, fixed_test) check and
+ * run exactly what the firmware does. Declared constexpr, so they fold into integer multipliers at compile time and no
+ * float code runs per sample.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "config.h"
+#include "fixed_point.h"
+#include "../../libs/FX29/fx29_units.h"
+
+#define POT_SPEED_PER_ADC   0.0243      ///< Speed % per potentiometer ADC count; 1 % at the bottom of the travel.
+
+constexpr LinearMap<16> inaToMilliamps(INA219_MAX_AMPS / 32768 * 1000, 0);                     ///< INA219 current register to mA.
+constexpr LinearMap<16> fx29ToNewtons(FX29_N_PER_COUNT, -FX29_ZERO_COUNTS * FX29_N_PER_COUNT);  ///< FX29 bridge data to N.
+constexpr LinearMap<16, 16> batToPercent(BAT_ADC_PER, 0);               ///< Battery ADC counts above BAT_MIN_ADC to %.
+constexpr LinearMap<16, 16> potToSpeed(POT_SPEED_PER_ADC, 1);           ///< Potentiometer ADC counts to speed in %.
+constexpr LinearMap<16> countsToRev(1.0 / (ENCODER_CPR * (double)ENCODER_GEAR), 0.0);  ///< Encoder counts to output revolutions.
+
+/**
+ * @brief Battery charge in % from an averaged battery ADC reading, clamped to BAT_MIN_ADC..BAT_MAX_ADC.
+ *
+ */
+constexpr q16_t batteryPercent(q16_t adc) {
+    return batToPercent(fixed_clamp(adc, q16_t(BAT_MIN_ADC), q16_t(BAT_MAX_ADC)) - q16_t(BAT_MIN_ADC));
+}
@@ -0,0 +1,65 @@
+/**
+ * @file seqlock.h
+ * @author Thomas Chang
+ * @brief Single writer sequence lock used to publish the latest sensor snapshot from core 0 to core 1.
+ * @details The writer never waits. Readers retry until they copy the value without a concurrent write, which is cheap
+ * because the writer only holds the odd sequence number for the duration of one struct copy.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+template <typename T>
+class Seqlock {
+public:
+    /**
+     * @brief Publishes a new value. Must only be called from a single core/context.
+     *
+     * @param value The value to publish.
+     */
+    void write(const T& value) {
+        uint32_t seq = _seq.load(std::memory_order_relaxed);
+        _seq.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        _data = value;
+        std::atomic_thread_fence(std::memory_order_release);
+        _seq.store(seq + 2, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Copies out the most recently published value. Retries while a write is in progress.
+     *
+     * @return T A consistent copy of the latest value.
+     */
+    T read() const {
+        T copy;
+        uint32_t before, after;
+        do {
+            before = _seq.load(std::memory_order_acquire);
+            copy = _data;
+            std::atomic_thread_fence(std::memory_order_acquire);
+            after = _seq.load(std::memory_order_relaxed);
+        } while ((before & 1) || before != after);
+        return copy;
+    }
+
+    /**
+     * @brief Number of completed writes. Lets a reader skip work when nothing changed.
+     *
+     * @return uint32_t
+     */
+    uint32_t version() const {
+        return _seq.load(std::memory_order_acquire) >> 1;
+    }
+
+private:
+    std::atomic<uint32_t> _seq{0};
+    T _data{};
+};
@@ -0,0 +1,111 @@
+/**
+ * @file speed_control.h
+ * @author Thomas Chang
+ * @brief Prototypes for the closed-loop motor speed controller. Core 0 only.
+ * @details A repeating timer on its own hardware alarm runs the loop at SPEED_CTRL_HZ. Every tick it updates the
+ * encoder velocity, runs the speed PID and writes the PWM through setMotor(), so the loop rate does not depend on how
+ * long the scheduler tasks take. The timer interrupt owns the encoder: the rest of the firmware reads the position and
+ * speed it cached (speed_control_count(), speed_control_rpm()) instead of touching the PIO FIFOs.
+ *
+ * The PID itself is in speed_pid.h. The tick body, the commands and the limits are in speed_loop.h, which has no SDK
+ * calls; this module runs it on the timer and gives it the encoder and the bridge (speed_hal.h).
+ *
+ * A closed-loop move can be given an end position (speed_control_limit()). The loop then runs the predictive stop
+ * (stop_predict.h) every tick and cuts the PWM itself when the needle would coast onto the limit, without waiting for
+ * the scheduler to notice; the cut holds whatever target is set until the limit is re-armed or cleared. The same call
+ * arms a hard limit STOP_HARD_MARGIN counts further in PIO (quad_encoder_init_limit()): if the needle gets there, its
+ * interrupt zeroes the PWM within microseconds, even while the loop or anything else is stalled. The distance is taken
+ * from the position of the last tick, so the hard limit can sit up to one tick of travel late. Open loop moves clear
+ * both.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "pico/stdlib.h"
+#include "../../libs/QUAD_ENC/quad_encoder.h"
+#include "speed_loop.h"
+
+/**
+ * @brief Starts the control loop with the motor off.
+ *
+ * @param enc Encoder set up with quad_encoder_init() and quad_encoder_init_timing(). Owned by the loop from now on.
+ * @param cfg PID tuning, copied.
+ * @param stop_cfg Tuning of the end-of-travel stop, copied.
+ * @return false if the hard limit could not be set up or the repeating timer could not be armed. The loop is not
+ * running then and the motor must not be driven.
+ */
+bool speed_control_start(quad_encoder_t* enc, const speed_pid_config_t* cfg, const stop_config_t* stop_cfg);
+
+/**
+ * @brief Holds a target speed. A new direction restarts the PID from a standstill output.
+ *
+ * @param direction MOTOR_FW or MOTOR_BW.
+ * @param target_rpm Output shaft RPM; 0 stops the motor.
+ */
+void speed_control_set(bool direction, float target_rpm);
+
+/**
+ * @brief Applies a fixed PWM level without feedback, e.g. to drive into a hard stop. Clears the travel limits.
+ *
+ * @param direction MOTOR_FW or MOTOR_BW.
+ * @param power PWM level 0-255.
+ */
+void speed_control_open_loop(bool direction, uint16_t power);
+
+/**
+ * @brief Stops the motor (PWM 0) and resets the PID.
+ *
+ */
+void speed_control_stop();
+
+/**
+ * @brief Output shaft speed at the last tick, RPM. Positive when the needle moves forward.
+ *
+ */
+float speed_control_rpm();
+
+/**
+ * @brief Encoder position at the last tick, in counts, positive forward (ENCODER_SIGN applied).
+ *
+ */
+int32_t speed_control_count();
+
+/**
+ * @brief Makes the position at the last tick read as 0.
+ *
+ */
+void speed_control_zero();
+
+/**
+ * @brief Arms the end-of-travel stop for closed-loop moves toward limit, and the hard limit behind it.
+ *
+ * @param limit End position in counts, as speed_control_count().
+ */
+void speed_control_limit(int32_t limit);
+
+/**
+ * @brief Disarms the end-of-travel stop and the hard limit and releases a cut.
+ *
+ */
+void speed_control_clear_limit();
+
+/**
+ * @brief True while the end-of-travel stop or the hard limit holds the PWM off.
+ *
+ */
+bool speed_control_at_limit();
+
+/**
+ * @brief Copy of the end-of-travel stop: limit, cut and rest position of the last stop, learned coast time.
+ *
+ */
+stop_predictor_t speed_control_stop_report();
+
+speed_control_stats_t speed_control_stats();
+
+void speed_control_reset_stats();
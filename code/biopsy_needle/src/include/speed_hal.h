@@ -0,0 +1,61 @@
+/**
+ * @file speed_hal.h
+ * @author Thomas Chang
+ * @brief Everything the speed loop (speed_loop.h) needs from the platform it runs on.
+ * @details The loop never touches hardware or the SDK. It reads the encoder, arms the hard limit and writes the PWM
+ * through these calls, which the firmware implements in speed_control.cpp on top of quad_encoder.h and setMotor(), and
+ * the host simulator (tools/host_sim) implements on top of its motor model and a model of the PIO state machines.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Updates the M/T velocity estimate, see quad_encoder_update_velocity().
+ *
+ * @param now_us Current time in microseconds.
+ * @return float Counts per second, positive forward.
+ */
+float speed_hal_velocity(uint32_t now_us);
+
+/**
+ * @brief Position at the last speed_hal_velocity() call in counts, positive forward.
+ *
+ */
+int32_t speed_hal_position();
+
+/**
+ * @brief Makes the position at the last speed_hal_velocity() call read as 0.
+ *
+ */
+void speed_hal_zero();
+
+/**
+ * @brief (Re-)arms the hard limit, see quad_encoder_arm_limit(). Its callback is speed_loop_trip() after cutting the
+ * PWM.
+ *
+ */
+void speed_hal_arm_limit(int32_t position, int32_t limit, bool increasing);
+
+void speed_hal_disarm_limit();
+
+/**
+ * @brief Writes the bridge, see setMotor().
+ *
+ */
+void speed_hal_motor(bool direction, uint16_t pwm);
+
+/**
+ * @brief Keeps the loop tick and the hard limit callback out until speed_hal_unlock().
+ *
+ * @return uint32_t State to hand to speed_hal_unlock().
+ */
+uint32_t speed_hal_lock();
+
+void speed_hal_unlock(uint32_t state);
@@ -0,0 +1,129 @@
+/**
+ * @file speed_loop.h
+ * @author Thomas Chang
+ * @brief Prototypes for the body of the closed-loop speed controller: the tick, the commands and the travel limits.
+ * @details Every tick reads the M/T speed and the position, re-arms the hard limit from that position, runs the
+ * predictive stop and the speed PID, and writes the PWM unless the hard limit tripped in the meantime. The commands
+ * and the limits change the state with the tick locked out, so it never sees half of a change.
+ *
+ * Plain C++ without hardware access: the encoder, the hard limit and the bridge are reached through speed_hal.h. The
+ * firmware runs it from the timer interrupt of speed_control.cpp, the host simulator (tools/host_sim) on simulated
+ * time.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "config.h"
+#include "speed_pid.h"
+#include "stop_predict.h"
+
+enum speed_mode {
+    SPEED_OFF,
+    SPEED_CLOSED,
+    SPEED_OPEN
+};
+
+/**
+ * @brief Counters of the controller since it was started.
+ *
+ */
+typedef struct {
+    uint32_t ticks;         ///< Loop iterations.
+    uint32_t limited;       ///< Closed-loop ticks whose output was held by a limit.
+    uint32_t max_exec_us;   ///< Worst time spent in the timer interrupt.
+    uint32_t limit_trips;   ///< Cuts by the hard limit.
+} speed_control_stats_t;
+
+/**
+ * @brief State of the loop. The command is written with the tick locked out, the rest by the tick and the hard limit.
+ *
+ */
+typedef struct {
+    speed_pid_t pid;
+    stop_predictor_t stopper;
+
+    volatile uint8_t mode;          ///< speed_mode
+    volatile bool dir;
+    volatile float target;          ///< RPM in closed loop.
+    volatile uint16_t open_pwm;
+    volatile bool restart;          ///< Reset the PID on the next tick.
+
+    volatile float speed_rpm;       ///< At the last tick.
+    volatile int32_t position;      ///< At the last tick.
+    volatile bool at_limit;         ///< The predictive stop has cut the PWM.
+    volatile bool tripped;          ///< The hard limit has cut the PWM.
+    volatile bool hard_armed;       ///< A hard limit is set; re-armed every tick until it trips or is cleared.
+    volatile int32_t hard_limit;
+    volatile bool hard_up;          ///< The hard limit lies toward higher counts.
+    speed_control_stats_t stats;
+} speed_loop_t;
+
+/**
+ * @brief Sets up the loop with the motor off and no limit.
+ *
+ * @param loop Loop.
+ * @param cfg PID tuning, copied.
+ * @param stop_cfg Tuning of the end-of-travel stop, copied.
+ */
+void speed_loop_init(speed_loop_t* loop, const speed_pid_config_t* cfg, const stop_config_t* stop_cfg);
+
+/**
+ * @brief One tick at SPEED_CTRL_HZ.
+ *
+ * @param loop Loop.
+ * @param now_us Time at the start of the tick.
+ * @param lag_s Time from the start of a tick to its PWM write, for the predictive stop (the last tick's run time).
+ */
+void speed_loop_tick(speed_loop_t* loop, uint32_t now_us, float lag_s);
+
+/**
+ * @brief Holds a target speed; 0 stops the motor. A new direction restarts the PID from a standstill output.
+ *
+ */
+void speed_loop_set(speed_loop_t* loop, bool direction, float target_rpm);
+
+/**
+ * @brief Applies a fixed PWM level without feedback. Clears the travel limits.
+ *
+ */
+void speed_loop_open_loop(speed_loop_t* loop, bool direction, uint16_t power);
+
+void speed_loop_stop(speed_loop_t* loop);
+
+/**
+ * @brief Makes the position at the last tick read as 0.
+ *
+ */
+void speed_loop_zero(speed_loop_t* loop);
+
+/**
+ * @brief Arms the predictive stop toward limit and the hard limit STOP_HARD_MARGIN counts behind it.
+ *
+ */
+void speed_loop_limit(speed_loop_t* loop, int32_t limit);
+
+void speed_loop_clear_limit(speed_loop_t* loop);
+
+/**
+ * @brief The hard limit was reached. Called from its callback after the PWM has been cut.
+ *
+ */
+static inline void speed_loop_trip(speed_loop_t* loop) {
+    loop->tripped = true;
+    loop->stats.limit_trips++;
+}
+
+/**
+ * @brief True while the end-of-travel stop or the hard limit holds the PWM off.
+ *
+ */
+static inline bool speed_loop_at_limit(const speed_loop_t* loop) {
+    return loop->at_limit || loop->tripped;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file speed_pid.h
+ * @author Thomas Chang
+ * @brief Prototypes for the motor speed PID used by the speed controller (speed_control.h).
+ * @details The PID works on output RPM in the commanded direction:
+ *
+ *     pwm = kff * target + ff0 + kp * e + I + D,  e = target - speed
+ *
+ * Feed-forward supplies the PWM the unloaded motor needs for the target, so the PID only has to make up for the load.
+ * D acts on the measured speed (no kick when the target changes) through a one-pole smoother. The output is clamped
+ * to [0, out_max] and its change per tick is limited by the slew rate. While the output is held by either limit, the
+ * integrator does not grow in the limited direction (anti-windup).
+ *
+ * Plain C++ without hardware access, so the host simulator (tools/host_sim) runs the same loop.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdbool.h>
+
+/**
+ * @brief Tuning of the speed PID. See config.h for the defaults.
+ *
+ */
+typedef struct {
+    float kp;           ///< PWM levels per RPM of error.
+    float ki;           ///< PWM levels per RPM second of error.
+    float kd;           ///< PWM levels per RPM/s of speed change.
+    float kff;          ///< Feed-forward PWM levels per target RPM.
+    float ff0;          ///< Feed-forward offset while the target is above 0 (static friction).
+    float slew;         ///< Largest output change, PWM levels per second.
+    float out_max;      ///< Output limit.
+    float d_alpha;      ///< Smoothing of the D term, 0 < d_alpha <= 1.
+} speed_pid_config_t;
+
+/**
+ * @brief State of one PID.
+ *
+ */
+typedef struct {
+    speed_pid_config_t cfg;
+    float integ;        ///< Integral term in PWM levels.
+    float d_term;       ///< Smoothed D term.
+    float prev_speed;
+    float out;          ///< Last output.
+    bool limited;       ///< The last output was held by the clamp or the slew limit.
+} speed_pid_t;
+
+void speed_pid_init(speed_pid_t* pid, const speed_pid_config_t* cfg);
+
+/**
+ * @brief Clears the integrator and the D history and makes out the starting point of the slew limit.
+ *
+ */
+void speed_pid_reset(speed_pid_t* pid, float out);
+
+/**
+ * @brief One PID step.
+ *
+ * @param pid PID.
+ * @param target Target speed, RPM. 0 or below stops the output and resets the PID.
+ * @param speed Measured speed in the target's direction, RPM.
+ * @param dt Step length in seconds.
+ * @return float PWM level.
+ */
+float speed_pid_update(speed_pid_t* pid, float target, float speed, float dt);
@@ -0,0 +1,164 @@
+/**
+ * @file spsc_ring.h
+ * @author Thomas Chang
+ * @brief Fixed capacity, lock-free, single-producer/single-consumer ring buffer.
+ * @details Carries log records from the acquisition side on core 0 to the SD logger on core 1. The producer never
+ * blocks: when the ring is full the record is dropped and counted. The consumer can drain in bulk by borrowing a
+ * contiguous span of the storage and releasing it once written, which avoids a copy per record.
+ *
+ * Head and tail are free-running 32 bit counters; only the producer writes head and only the consumer writes tail, so
+ * a single release/acquire pair per operation is all the synchronization needed.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * @brief Counters describing how well the consumer keeps up with the producer.
+ *
+ */
+typedef struct {
+    uint32_t pushed;        ///< Items accepted by the ring.
+    uint32_t popped;        ///< Items released by the consumer.
+    uint32_t dropped;       ///< Items rejected because the ring was full.
+    uint32_t high_water;    ///< Largest occupancy observed by the producer.
+    uint32_t lag;           ///< Items currently waiting for the consumer.
+} ring_stats_t;
+
+template <typename T, uint32_t N>
+class SpscRing {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "SpscRing capacity must be a power of two");
+
+public:
+    /**
+     * @brief Producer side. Copies item into the ring, or drops it if the ring is full.
+     *
+     * @param item The item to append.
+     * @return true if the item was queued, false if it was dropped.
+     */
+    bool push(const T& item) {
+        if (!try_push(item)) {
+            _dropped++;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Producer side. Like push() but a full ring is not counted as a drop, for callers that retry.
+     *
+     * @param item The item to append.
+     * @return true if the item was queued.
+     */
+    bool try_push(const T& item) {
+        uint32_t head = _head.load(std::memory_order_relaxed);
+        uint32_t used = head - _tail.load(std::memory_order_acquire);
+        if (used >= N) {
+            return false;
+        }
+        _buf[head & (N - 1)] = item;
+        _head.store(head + 1, std::memory_order_release);
+        if (used + 1 > _high_water) {
+            _high_water = used + 1;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Consumer side. Copies out the oldest item.
+     *
+     * @param out Destination.
+     * @return true if an item was available.
+     */
+    bool pop(T& out) {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        if (_head.load(std::memory_order_acquire) == tail) {
+            return false;
+        }
+        out = _buf[tail & (N - 1)];
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Consumer side. Borrows the longest contiguous run of queued items without copying them.
+     * @details The span stops at the end of the storage array; call again after release() to get the wrapped part.
+     * @param span Set to the first queued item.
+     * @return uint32_t Number of items in the span, 0 if the ring is empty.
+     */
+    uint32_t peek_span(const T** span) {
+        uint32_t tail = _tail.load(std::memory_order_relaxed);
+        uint32_t avail = _head.load(std::memory_order_acquire) - tail;
+        uint32_t idx = tail & (N - 1);
+        if (avail > N - idx) {
+            avail = N - idx;
+        }
+        *span = &_buf[idx];
+        return avail;
+    }
+
+    /**
+     * @brief Consumer side. Hands count items obtained from peek_span() back to the producer.
+     *
+     * @param count Number of items consumed.
+     */
+    void release(uint32_t count) {
+        _tail.store(_tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    /**
+     * @brief Number of queued items. Exact on either side, approximate from a third party.
+     *
+     * @return uint32_t
+     */
+    uint32_t size() const {
+        return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+    }
+
+    /**
+     * @brief Capacity of the ring in items.
+     *
+     * @return uint32_t
+     */
+    static constexpr uint32_t capacity() {
+        return N;
+    }
+
+    /**
+     * @brief Snapshot of the ring counters.
+     *
+     * @return ring_stats_t
+     */
+    ring_stats_t stats() const {
+        ring_stats_t s;
+        s.pushed = _head.load(std::memory_order_acquire);
+        s.popped = _tail.load(std::memory_order_acquire);
+        s.dropped = _dropped;
+        s.high_water = _high_water;
+        s.lag = s.pushed - s.popped;
+        return s;
+    }
+
+    /**
+     * @brief Producer side. Clears the drop and high-water counters, for example at the start of a run.
+     *
+     */
+    void reset_stats() {
+        _dropped = 0;
+        _high_water = size();
+    }
+
+private:
+    T _buf[N];
+    std::atomic<uint32_t> _head{0};     ///< Written by the producer only.
+    std::atomic<uint32_t> _tail{0};     ///< Written by the consumer only.
+    volatile uint32_t _dropped = 0;     ///< Written by the producer only.
+    volatile uint32_t _high_water = 0;  ///< Written by the producer only.
+};
@@ -0,0 +1,131 @@
+/**
+ * @file stall_detect.h
+ * @author Thomas Chang
+ * @brief Prototypes for the motor stall and collision detector. Core 0 only.
+ * @details The detector is fed once per control tick with the motor command, the encoder count, the output speed and
+ * the motor current, and decides from all of them together whether the needle has run into something:
+ *
+ *  - STARTING: PWM rising above cfg.pwm_min or a direction change starts a motion; the PWM may vary within it, as
+ *    it does under the speed controller. The startup current spike is ignored simply because the encoder is moving.
+ *    Only a motor that does not move a single count for cfg.start_us while drawing at least cfg.min_mA is stalled
+ *    (blocked from rest).
+ *  - RUNNING: entered after cfg.arm_counts of travel. The detector follows the normal speed (a peak that decays
+ *    slowly) and the normal current (a slow average). A collision shows as the speed collapsing below
+ *    cfg.vel_frac of normal while the current either climbs fast (slope >= cfg.slope_mA_ms) or sits cfg.rise_mA
+ *    above normal; both must hold for cfg.confirm_us. A gradual load change moves the references along and does
+ *    not trip it. The measured speed keeps the last count period until the next count, so while no count comes the
+ *    speed is also capped at what the time since the last count allows: a blocked motor reads as collapsed after
+ *    about two count periods at the normal speed, at any speed. The current thresholds are for pwm_full and scale
+ *    with the commanded PWM, because a blocked motor draws current in proportion to its drive voltage.
+ *  - DETECTED: latched until the motor is stopped or reversed, so the caller can act on it on any later tick.
+ *
+ * Nothing depends on a fixed time after start or on an absolute current, so the same settings work with another
+ * motor or battery voltage.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include "fixed_point.h"
+
+#define STALL_SLOPE_TAPS    4       ///< Current slope is taken over this many updates (4 ms at CONTROL_HZ).
+
+typedef enum {
+    STALL_IDLE,         ///< Motor commanded below pwm_min.
+    STALL_STARTING,     ///< Moving off; not yet armed.
+    STALL_RUNNING,      ///< Armed and watching for a collision.
+    STALL_DETECTED      ///< Stalled; latched until the motor is stopped or reversed.
+} stall_state_t;
+
+typedef enum {
+    STALL_NONE,
+    STALL_NO_START,     ///< The motor never moved.
+    STALL_STOPPED,      ///< The motor stopped dead while running.
+    STALL_COLLISION     ///< Speed collapse together with a current step.
+} stall_reason_t;
+
+/**
+ * @brief Tuning of the detector. See config.h for the defaults and their meaning.
+ *
+ */
+typedef struct {
+    uint16_t pwm_min;       ///< Commands below this are treated as stopped.
+    uint16_t pwm_full;      ///< PWM level slope_mA_ms and rise_mA are given for.
+    int32_t arm_counts;     ///< Travel in encoder counts before RUNNING.
+    uint32_t start_us;      ///< No count for this long while powered is a stall.
+    float vel_frac;         ///< Speed below this fraction of normal is a collapse.
+    float rpm_count_us;     ///< Speed in rpm times the time per encoder count in us (60e6 / counts per revolution).
+    q16_t slope_mA_ms;      ///< Current slope that counts as a load step.
+    q16_t rise_mA;          ///< Current above normal that counts as a load step.
+    q16_t min_mA;           ///< Current that shows the motor is really powered.
+    uint32_t confirm_us;    ///< Collapse and load step must hold this long.
+} stall_config_t;
+
+/**
+ * @brief State of one detector.
+ *
+ */
+typedef struct {
+    stall_config_t cfg;
+    stall_state_t state;
+    stall_reason_t reason;
+    bool dir;
+    int32_t start_count;            ///< Count when the motion started.
+    int32_t last_count;
+    uint32_t moved_us;              ///< Time of the last count change.
+    float ref_rpm;                  ///< Normal speed: peak, decaying slowly.
+    q16_t ref_mA;                   ///< Normal current: slow average.
+    q16_t slope;                    ///< Current slope in mA/ms.
+    q16_t hist_mA[STALL_SLOPE_TAPS];
+    uint32_t hist_us[STALL_SLOPE_TAPS];
+    uint8_t hist_idx;
+    uint8_t hist_n;
+    bool evidence;                  ///< Collapse and load step seen on the last update.
+    uint32_t evidence_us;           ///< Time the current run of evidence began.
+    uint32_t evidence_len_us;       ///< Evidence of the last stall: from collapse and load step, or from the last count.
+    uint32_t detections;            ///< Stalls since stall_init().
+} stall_detector_t;
+
+/**
+ * @brief Sets the tuning and resets the detector to STALL_IDLE.
+ *
+ * @param sd Detector.
+ * @param cfg Tuning, copied.
+ */
+void stall_init(stall_detector_t* sd, const stall_config_t* cfg);
+
+/**
+ * @brief Forgets the current motion; the next update with a command above pwm_min starts a new one.
+ *
+ * @param sd Detector.
+ */
+void stall_reset(stall_detector_t* sd);
+
+/**
+ * @brief Feeds one control tick.
+ *
+ * @param sd Detector.
+ * @param dir Commanded direction (MOTOR_FW/MOTOR_BW).
+ * @param pwm Commanded PWM level.
+ * @param count Encoder count.
+ * @param rpm Output speed, magnitude.
+ * @param current_mA Motor current.
+ * @param now_us time_us_32().
+ * @return stall_state_t The new state.
+ */
+stall_state_t stall_update(stall_detector_t* sd, bool dir, uint16_t pwm, int32_t count, float rpm, q16_t current_mA,
+                           uint32_t now_us);
+
+/**
+ * @brief Name of a stall reason, for reports.
+ *
+ * @param reason Reason.
+ * @return const char*
+ */
+const char* stall_reason_name(stall_reason_t reason);
@@ -0,0 +1,95 @@
+/**
+ * @file stop_predict.h
+ * @author Thomas Chang
+ * @brief Prototypes for the predictive end-of-travel stop. No hardware access, so the host simulation
+ * (tools/stop_sim) runs the same code.
+ * @details The needle keeps moving after the PWM is cut: for the latency until the cut reaches the motor, and then
+ * while it brakes. The predictor is fed the position and speed every control tick and cuts when the needle would
+ * land on the limit:
+ *
+ *     coast = v * (lag + tau)
+ *     land  = remaining - coast              (> 0: short of the limit)
+ *
+ * The motor mostly brakes on its own back EMF, which pulls harder the faster it turns, so the speed decays with a time
+ * constant and the coast grows with v, not with v^2 as under a constant deceleration. A constant deceleration learned
+ * at one speed does not carry over to another: learned from a crawl it puts the cut of a stop from full speed hundreds
+ * of counts early.
+ *
+ * It cuts on this tick if cutting on the next one would land further past the limit than cutting now lands short of
+ * it, so the landing error is at most half the travel of one tick. After the cut it waits for the needle to come to
+ * rest, records where it landed and learns tau from the coast it saw, so the battery, the motor and the tissue are
+ * calibrated out over a few runs.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/**
+ * @brief Tuning of the predictor. See config.h for the defaults.
+ *
+ */
+typedef struct {
+    float tau;          ///< Coast time (coast over speed) before anything was learned, s.
+    float tau_min;      ///< Learned values are kept within [tau_min, tau_max].
+    float tau_max;
+    float learn;        ///< Weight of a new measurement, 0 (never learn) to 1 (only the last stop).
+} stop_config_t;
+
+/**
+ * @brief State of the predictor and the result of the last stop. Positions in encoder counts, speeds in counts/s,
+ * both positive forward.
+ *
+ */
+typedef struct {
+    stop_config_t cfg;
+    float tau;              ///< Learned coast time, s.
+    bool armed;
+    bool forward;           ///< The limit lies ahead in the forward direction.
+    int32_t limit;          ///< Requested end position.
+    bool cut;               ///< The PWM has been cut for this limit.
+    bool settled;           ///< The needle came to rest after the cut.
+    int32_t cut_at;         ///< Position when the cut was made.
+    float cut_cps;          ///< Speed toward the limit when the cut was made.
+    float predicted;        ///< Predicted landing position.
+    int32_t rest_at;        ///< Position the needle came to rest at.
+    uint32_t stops;         ///< Settled stops since stop_init().
+} stop_predictor_t;
+
+void stop_init(stop_predictor_t* sp, const stop_config_t* cfg);
+
+/**
+ * @brief Arms a new limit. The previous stop result is cleared; the learned coast time is kept.
+ *
+ * @param sp Predictor.
+ * @param position Current position.
+ * @param limit End position.
+ */
+void stop_arm(stop_predictor_t* sp, int32_t position, int32_t limit);
+
+void stop_disarm(stop_predictor_t* sp);
+
+/**
+ * @brief Feeds one control tick.
+ *
+ * @param sp Predictor.
+ * @param position Measured position.
+ * @param cps Measured speed; 0 once the needle stands still.
+ * @param period Time to the next update, s.
+ * @param lag Time from the measurement to the PWM write, s.
+ * @return true while the PWM must be held off.
+ */
+bool stop_update(stop_predictor_t* sp, int32_t position, float cps, float period, float lag);
+
+/**
+ * @brief Landing error of the last settled stop in counts, positive past the limit.
+ *
+ */
+static inline int32_t stop_error(const stop_predictor_t* sp) {
+    return sp->forward ? sp->rest_at - sp->limit : sp->limit - sp->rest_at;
+}
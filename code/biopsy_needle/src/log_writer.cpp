@@ -0,0 +1,108 @@
+/**
+ * @file log_writer.cpp
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the preallocated, chunked SD run log writer.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "include/log_writer.h"
+#include "include/config.h"
+
+#include "pico/stdlib.h"
+#include <string.h>
+
+static FIL* log_fil = NULL;
+static uint8_t chunk[LOG_CHUNK_BYTES] __attribute__((aligned(4)));
+static uint32_t chunk_len = 0;
+static DWORD clmt[4];           ///< Fast seek map: size, one (length, start cluster) fragment, terminator.
+static log_writer_stats_t stats;
+
+/**
+ * @brief Hands the filled part of the chunk to FatFS.
+ *
+ * @return true if every byte was written.
+ */
+static bool flush_chunk() {
+    if (chunk_len == 0) {
+        return true;
+    }
+
+    // The cluster map only covers the preallocated extent. Past it, let FatFS follow and grow the chain itself.
+    if (log_fil->cltbl && f_tell(log_fil) + chunk_len > LOG_PREALLOC_BYTES) {
+        log_fil->cltbl = NULL;
+    }
+
+    UINT written = 0;
+    uint32_t start = time_us_32();
+    FRESULT fr = f_write(log_fil, chunk, chunk_len, &written);
+    uint32_t elapsed = time_us_32() - start;
+
+    stats.chunks++;
+    stats.total_write_us += elapsed;
+    if (elapsed > stats.max_write_us) {
+        stats.max_write_us = elapsed;
+    }
+
+    bool ok = (fr == FR_OK && written == chunk_len);
+    if (!ok) {
+        stats.errors++;
+    }
+    chunk_len = 0;
+    return ok;
+}
+
+FRESULT log_writer_open(FIL* fil) {
+    log_fil = fil;
+    chunk_len = 0;
+    memset(&stats, 0, sizeof(stats));
+
+    FRESULT fr = f_expand(fil, LOG_PREALLOC_BYTES, 1);
+    if (fr == FR_OK) {
+        // f_expand allocates one run of clusters, so the map has exactly one fragment and needs no FAT walk.
+        FATFS* fs = fil->obj.fs;
+        DWORD cluster_bytes = (DWORD)fs->csize * 512;
+        clmt[0] = 4;
+        clmt[1] = (LOG_PREALLOC_BYTES + cluster_bytes - 1) / cluster_bytes;
+        clmt[2] = fil->obj.sclust;
+        clmt[3] = 0;
+        fil->cltbl = clmt;
+        stats.contiguous = true;
+    }
+    return fr;
+}
+
+bool log_writer_write(const void* data, uint32_t len) {
+    const uint8_t* src = (const uint8_t*)data;
+    bool ok = true;
+    while (len > 0) {
+        uint32_t n = NTM_MIN(len, LOG_CHUNK_BYTES - chunk_len);
+        memcpy(&chunk[chunk_len], src, n);
+        chunk_len += n;
+        src += n;
+        len -= n;
+        stats.bytes += n;
+        if (chunk_len == LOG_CHUNK_BYTES) {
+            ok &= flush_chunk();
+        }
+    }
+    return ok;
+}
+
+FRESULT log_writer_close() {
+    if (!log_fil) {
+        return FR_INVALID_OBJECT;
+    }
+    flush_chunk();
+    log_fil->cltbl = NULL;
+    FRESULT fr = f_truncate(log_fil);
+    log_fil = NULL;
+    return fr;
+}
+
+log_writer_stats_t log_writer_stats() {
+    return stats;
+}
@@ -16,35 +16,52 @@
 #include "../libs/SSD1306/ssd1306.h"
 #include "../libs/FX29/fx29.h"
 
-using namespace std;
-
-// ==== Experimental Values ==== //
-int fwRev = 50;             ///< Sets the max forward revolutions of the device from start position. Current ratio of (revolutions : distance) = (2 : 1)
-int bwRev = 0;              ///< Sets the max backwards revolutions of the device from start position. Current ratio of (revolutions : distance) = (2 : 1)
-#define MAF_SZ      5       ///< Window size for Moving Average Filter.
-#define LP_ALPHA    0.1f    ///< Smoothing factor for LP Filter
+#include "include/scheduler.h"
+#include "include/core_link.h"
+#include "include/runlog.h"
+#include "include/log_writer.h"
+#include "include/run_index.h"
+#include "include/ntm_format.h"
+#include "include/adc_sampler.h"
+#include "include/speed_control.h"
+#include "include/control_core.h"
+#include "include/control_hal.h"
+#include "include/sensor_units.h"
+
+#include "pico/multicore.h"
+#include <math.h>
+
+// ==== Unit Conversions (see sensor_units.h) ==== //
+constexpr float CPS_PER_RPM = ENCODER_CPR * ENCODER_GEAR / 60.0f; ///< Output RPM to encoder counts/s.
 
 // ==== Function Prototypes ==== //
 #pragma region LOCAL PROTOTYPES
 
 void oled_init();
-void displayInputSpeed(int y_pos);
-void displayBat(int y_pos);
-void displayState();
+void displayInputSpeed(int y_pos, long speed);
+void displayBat(int y_pos, long bat);
+void displayState(const status_snapshot_t& snap);
 void handleButton();
 void handleRelease();
 void handleMSCButton();
 void createDataFile();
-void resetFiltering();
-float getBatLevel();
+long getBatLevel();
 long getInputSpeed();
-void getRPM();
 void enableMSC();
 void disableMSC();
 void testingSuite();
 void testMSC();
 void testSD();
 void testPins();
+void controlTask(uint64_t release_us);
+void currentTask(uint64_t release_us);
+void forceTask(uint64_t release_us);
+void inputTask(uint64_t release_us);
+void publishSnapshot();
+void printI2CStats();
+void reportStop();
+void core1_main();
+void handleLogMsg(const log_record_t& msg);
 
 #pragma endregion
 
@@ -52,28 +69,23 @@ void testPins();
 #pragma region GLOBALS
 
 ssd1306_t oled;
-uint16_t speed_lvl = 0;
-long temp_speed = 0;
-long bat_per = 0;
-int count = 0;
-int numPulses = 0;
 absolute_time_t now = get_absolute_time();
 absolute_time_t prevTime = get_absolute_time();
 absolute_time_t pressTime = get_absolute_time();
 absolute_time_t pressedTime = get_absolute_time();
 absolute_time_t mscPressTime = get_absolute_time();
-float rpm = 0;
-float current_mA = 0;
-float force = 0;
-float displacement = 0;
+float forceTemp = 0;
+uint32_t busSkips = 0;     ///< Sensor samples that reused the previous value because their I2C read had not completed.
+uint32_t inaStale = 0;     ///< Current samples that reused the previous value because the INA219 had no new conversion.
 
-float lp_current = 0;
-float MAF[MAF_SZ] = {0};
-int MAF_counter = 0;
-float MAF_sum = 0;
+INA219 ina219(MY_I2C, INA219_ADDR);
+fx29_async_t fx29;
 
 extern uint slice;
 extern uint channel;
+extern quad_encoder_t encoder;
+extern bool motorDir;
+extern uint16_t motorPower;
 
 #pragma endregion
 
@@ -94,30 +106,11 @@ volatile bool button_msc_flag = false;
 // ==== Data Logging ==== //
 FATFS filesys;
 FIL fil;
-TCHAR filename[20] = "data0.csv\0";
-
-// ==== Motor State Machine ==== //
-enum states {
-    WAIT,
-    STANDBY,
-    CUTTING,
-    REMOVAL,
-    EXITING,
-    FINISH,
-    ZERO
-};
-enum states state, nextState;
+TCHAR filename[32] = "";
 
 // ==== Interrupt Service Routines ==== //
 void gpio_ISR(uint gpio, uint32_t events) {
-    if (gpio == motorA_out) {
-        numPulses++;
-        if (gpio_get(MOTOR_DIR) == 0) {
-                count--;
-            } else {
-                count++;
-            }
-    } else if (gpio == state_input) {
+    if (gpio == state_input) {
         if (gpio_get(state_input) == 1) {
             pressTime = get_absolute_time();
             button_press_flag = true;
@@ -152,138 +145,333 @@ int main() {
     sleep_ms(1000);
     
     // ==== General Initialization ==== //
-    board_gpio_init();
+    if (!board_gpio_init()) {
+        panic("encoder: no free PIO state machine or program space\n");
+    }
+    adc_sampler_wait_ready();
     bat_per = getBatLevel();
     oled_init();
-    state = WAIT;
-    nextState = STANDBY;
-    INA219 ina219(MY_I2C, INA219_ADDR);
-    ina219.calibrate(0.1, 3.2);
+    control_init();
+    // Continuous conversions: averaged shunt (current) and a fast bus voltage, ~1.1 ms per conversion, so every
+    // current tick finds a new one. Bus voltage stays below 16 V on the single cell supply.
+    ina219.configure(INA219::BRNG_16V, INA219::PGA_320MV, INA219::ADC_9BIT, INA219::ADC_AVG2, INA219::MODE_BOTH_CONTINUOUS);
+    ina219.calibrate(INA219_SHUNT_OHMS, INA219_MAX_AMPS);
+    fx29.read_temp = true;
+    static constexpr speed_pid_config_t speedCfg = {SPEED_KP, SPEED_KI, SPEED_KD, SPEED_KFF, SPEED_FF0, SPEED_SLEW,
+                                                    (float)MOTOR_ON, SPEED_D_ALPHA};
+    static constexpr stop_config_t stopCfg = {STOP_COAST_S, STOP_COAST_MIN, STOP_COAST_MAX, STOP_LEARN};
+    if (!speed_control_start(&encoder, &speedCfg, &stopCfg)) {
+        panic("speed control: hard limit or timer could not be set up\n");
+    }
 
     // ==== Interrupts ==== //
-    gpio_set_irq_enabled_with_callback(motorA_out, GPIO_IRQ_EDGE_FALL, true, &gpio_ISR);
-    gpio_set_irq_enabled(state_input, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true);
+    gpio_set_irq_enabled_with_callback(state_input, GPIO_IRQ_EDGE_RISE | GPIO_IRQ_EDGE_FALL, true, &gpio_ISR);
     gpio_set_irq_enabled(msc_input, GPIO_IRQ_EDGE_FALL, true);
 
+    // ==== Core 1: Logging, Display, USB ==== //
+    publishSnapshot();
+    multicore_launch_core1(core1_main);
+
+    // ==== Rate Groups ==== //
+    scheduler_add_task("control", CONTROL_HZ, controlTask);
+    scheduler_add_task("current", CURRENT_HZ, currentTask);
+    scheduler_add_task("force", FORCE_HZ, forceTask);
+    scheduler_add_task("inputs", DISPLAY_HZ, inputTask);
+    scheduler_start();
+
     while(1) {
-        now = get_absolute_time();
-        int64_t time_ms = to_ms_since_boot(now);
+        scheduler_run_pending();
+    }
+    return 0;
+}
 
-        handleRelease();
-        handleButton();
-        handleMSCButton();
-        getRPM();
-        
-        bat_per = getBatLevel();
-        current_mA = ina219.read_current() * 1000;
-        displacement = getRevolutions(count) * 0.5f;
-        force = compute_force(FX29_read(MY_I2C, FX29_ADDR));
+#pragma region TASKS
+
+/**
+ * @brief Control rate group. Handles button input and runs the control core on the position and speed the speed
+ * controller measured (see control_core.h).
+ * @param release_us Ideal release time of this tick.
+ */
+void controlTask(uint64_t release_us) {
+    now = get_absolute_time();
+
+    handleRelease();
+    handleButton();
+    handleMSCButton();
+    control_tick(speed_control_count(), speed_control_rpm(), motorDir, motorPower, time_us_32());
+    reportStop();
+
+    publishSnapshot();
+}
 
-        if (MAF_counter == MAF_SZ) {
-            MAF_counter = 0;
+/**
+ * @brief Current rate group. Samples the INA219, updates the moving average and low pass filters, and logs a sample while cutting or exiting.
+ * 
+ * @param release_us Ideal release time of this tick. Used as the log timestamp so samples are uniformly spaced.
+ */
+void currentTask(uint64_t release_us) {
+    // Collect the conversion read on the previous tick and start the next read. Hold the previous value if the read
+    // is late or the INA219 had no new conversion.
+    ina219_sample_t sample;
+    q16_t mA = q16_t(0);    // only used when fresh
+    bool fresh = ina219.poll_sample(&sample);
+    if (fresh) {
+        mA = inaToMilliamps(sample.current_raw);
+    }
+    if (!ina219.request_sample(SEC_US / CURRENT_HZ)) {
+        busSkips++;         // the previous read is still on the bus
+    } else if (!fresh) {
+        inaStale++;         // the previous read found no new conversion
+    }
+
+    control_current(fresh, mA, motorPower, (uint32_t)release_us);
+}
+
+/**
+ * @brief Force rate group. Samples the FX29 load cell.
+ * @details The fetch queued on the previous tick is collected here. Only readings the sensor marks as new update the
+ * force; stale (already fetched) and faulty readings are dropped and counted in fx29.
+ * @param release_us Ideal release time of this tick.
+ */
+void forceTask(uint64_t release_us) {
+    fx29_sample_t sample;
+    if (FX29_fetch(&fx29, &sample)) {
+        if (sample.status == FX29_STATUS_VALID) {
+            control_force(fx29ToNewtons(sample.bridge));
+            forceTemp = sample.temperature;
         }
-        // Remove oldest value and add newest value to sum
-        MAF_sum -= MAF[MAF_counter];
-        MAF_sum += current_mA;
-        MAF[MAF_counter] = current_mA;
-
-        MAF_counter++;
-        float MAF_current = MAF_sum * 1.0f/MAF_SZ;
-
-        switch(state) {
-            case WAIT: {
-                enableMSC();
-                setMotor(MOTOR_FW, MOTOR_OFF);
-                nextState = STANDBY;
-                break;
-            }
-            case STANDBY: {
-                disableMSC();
-                setMotor(MOTOR_FW, MOTOR_OFF);
-                
-                temp_speed = getInputSpeed();
-                speed_lvl = uint16_t(temp_speed / 100.0f * 255.0f); 
-                
-                resetFiltering();
-                displayState();
-                nextState = CUTTING;
-                break;
-            }
-            case CUTTING: {
-                speed_lvl = speed_lvl;
-                lp_current = LP_ALPHA * current_mA + (1 - LP_ALPHA) * lp_current;
-                f_printf(&fil, "%s,%lld,%f,%f,%f,%f,%f,%f\n", "CUTTING", time_ms, current_mA, lp_current, MAF_current, rpm, displacement, force);
-
-                // ==== SAFETY CHECK ==== //
-                if (getRevolutions(count) > fwRev) {
-                    setMotor(MOTOR_BW, MOTOR_OFF);
-                    state = REMOVAL;
-                } else {
-                    setMotor(MOTOR_FW, speed_lvl);
-                }
-                
-                displayState();
-                nextState = REMOVAL;
-                break;
-            }
-            case REMOVAL: {
-                setMotor(MOTOR_BW, 0);
-
-                temp_speed = getInputSpeed();
-                speed_lvl = int(temp_speed / 100.0f * 255.0f);
-                resetFiltering();
-                
-                displayState();
-                nextState = EXITING;
-                break;
-            }
-            case EXITING: {
-                speed_lvl = speed_lvl;
-
-                lp_current = LP_ALPHA * current_mA + (1 - LP_ALPHA) * lp_current;
-                f_printf(&fil, "%s,%lld,%f,%f,%f,%f,%f,%f\n", "EXITING", time_ms, current_mA, lp_current, MAF_current, rpm, displacement, force);
-
-                // ==== SAFETY CHECK ==== //
-                if (getRevolutions(count) < bwRev) {
-                    setMotor(MOTOR_FW, MOTOR_OFF);
-                    state = FINISH;
-                } else {
-                    setMotor(MOTOR_BW, speed_lvl);
-                }
-                
-                displayState();
-                nextState = FINISH;
-                break;
-            }
-            case FINISH: {
-                f_close(&fil);
-                f_unmount("");
+    } else {
+        busSkips++;
+    }
+    FX29_request(&fx29, FX29_ADDR, SEC_US / FORCE_HZ);
+}
 
-                setMotor(MOTOR_FW, MOTOR_OFF);
+/**
+ * @brief Input rate group. Refreshes the battery level and, while a speed can be chosen, the speed potentiometer.
+ * 
+ * @param release_us Ideal release time of this tick.
+ */
+void inputTask(uint64_t release_us) {
+    adc_sampler_update();
+    control_inputs(getInputSpeed(), getBatLevel());
+}
 
-                displayState();
+/**
+ * @brief Publishes the values shown on the OLED so core 1 can draw them without touching core 0 state.
+ * @details Force and RPM are shown after their filter pipelines; the log keeps the raw values.
+ */
+void publishSnapshot() {
+    status_snapshot_t snap;
+    control_snapshot(&snap);
+    core_link_publish(&snap);
+}
 
-                nextState = STANDBY;
-                break;
+/**
+ * @brief Prints how much of the I2C bus each device used during the run and how long its transfers waited.
+ * 
+ */
+void printI2CStats() {
+    i2c_dma_device_stats_t devs[I2C_DMA_MAX_DEVICES];
+    uint32_t window = i2c_dma_device_stats(devs);
+    for (int i = 0; i < I2C_DMA_MAX_DEVICES; i++) {
+        if (devs[i].addr == 0) {
+            continue;
+        }
+        printf("i2c 0x%02x: %lu txns, %lu bytes, %.1f%% busy, max %lu us, max wait %lu us, %lu late\n", devs[i].addr,
+               (unsigned long)devs[i].txns, (unsigned long)devs[i].bytes, 100.0f * devs[i].busy_us / window,
+               (unsigned long)devs[i].max_busy_us, (unsigned long)devs[i].max_wait_us, (unsigned long)devs[i].late);
+    }
+    printf("fx29: %lu fresh, %lu stale, %lu faults, %.1f C\n", (unsigned long)fx29.fresh, (unsigned long)fx29.stale,
+           (unsigned long)fx29.faults, forceTemp);
+}
+
+/**
+ * @brief Prints the requested and achieved end position once the needle has come to rest after an end-of-travel stop.
+ * @details The rest position is only known ENCODER_ZERO_US after the last count, so this is polled every control tick.
+ */
+void reportStop() {
+    static uint32_t reported = 0;
+    stop_predictor_t sp = speed_control_stop_report();
+    if (sp.stops == reported) {
+        return;
+    }
+    reported = sp.stops;
+    printf("stop: requested %.3f mm, achieved %.3f mm (%+ld counts), cut at %.1f RPM, predicted %+.1f counts, "
+           "coast %.1f ms\n", (getRevolutions(sp.limit) * MM_PER_REV).to_float(),
+           (getRevolutions(sp.rest_at) * MM_PER_REV).to_float(), (long)stop_error(&sp), sp.cut_cps / CPS_PER_RPM,
+           sp.forward ? sp.predicted - sp.limit : sp.limit - sp.predicted, sp.tau * 1e3f);
+}
+
+#pragma endregion
+
+#pragma region CONTROL HAL
+
+// The control core's view of the board (see control_hal.h).
+
+void hal_speed_set(bool direction, float target_rpm) {
+    speed_control_set(direction, target_rpm);
+}
+
+void hal_speed_open_loop(bool direction, uint16_t power) {
+    speed_control_open_loop(direction, power);
+}
+
+void hal_speed_stop() {
+    speed_control_stop();
+}
+
+void hal_speed_limit(int32_t limit) {
+    speed_control_limit(limit);
+}
+
+void hal_speed_clear_limit() {
+    speed_control_clear_limit();
+}
+
+bool hal_speed_at_limit() {
+    return speed_control_at_limit();
+}
+
+void hal_speed_zero() {
+    speed_control_zero();
+}
+
+void hal_log(log_record_t* rec) {
+    core_link_push_record(rec);
+}
+
+void hal_send(uint8_t kind) {
+    core_link_send(kind);
+}
+
+void hal_run_start() {
+    // Read here on core 0, which owns them; core 1 only sees this copy when it writes the log header.
+    run_settings_t run = {(float)fwRev, (float)bwRev, targetRpm, speed_control_stop_report().tau * 1e3f};
+    core_link_publish_run(&run);
+    core_link_reset_stats();
+    i2c_dma_reset_stats();
+    speed_control_reset_stats();
+    fx29.fresh = fx29.stale = fx29.faults = 0;
+}
+
+void hal_run_finish() {
+    scheduler_print_stats();
+    ring_stats_t ring = core_link_stats();
+    printf("log ring: high water %lu/%d, dropped %lu, bus skips %lu, ina219 stale %lu\n",
+           (unsigned long)ring.high_water, LOG_RING_DEPTH, (unsigned long)ring.dropped, (unsigned long)busSkips,
+           (unsigned long)inaStale);
+    printI2CStats();
+    printf("stall: %lu detected, last %s after %lu us of evidence\n", (unsigned long)stall.detections,
+           stall_reason_name(stall.reason), (unsigned long)stall.evidence_len_us);
+    speed_control_stats_t sc = speed_control_stats();
+    printf("speed control: %lu ticks, %lu limited, max %lu us, %lu hard limit trips\n",
+           (unsigned long)sc.ticks, (unsigned long)sc.limited, (unsigned long)sc.max_exec_us,
+           (unsigned long)sc.limit_trips);
+}
+
+#pragma endregion
+
+#pragma region CORE 1
+
+/**
+ * @brief Entry point of core 1. Owns the SD card, the OLED, and TinyUSB servicing so that slow writes and display
+ * transfers never stretch the control period on core 0.
+ * @details Drains a bounded number of queued messages per pass so the display keeps refreshing even when the logger
+ * is saturated. The OLED is redrawn at DISPLAY_HZ from the latest published snapshot.
+ */
+void core1_main() {
+    bool mscEnabled = false;
+    absolute_time_t nextFrame = get_absolute_time();
+
+    while (1) {
+        const log_record_t* span;
+        uint32_t n = NTM_MIN(core_link_peek(&span), LOG_RING_DEPTH / 4);
+        for (uint32_t i = 0; i < n; i++) {
+            if (span[i].kind == MSG_MSC_ON) {
+                mscEnabled = true;
+            } else if (span[i].kind == MSG_MSC_OFF) {
+                mscEnabled = false;
             }
-            case ZERO: {
-                setMotor(MOTOR_BW, MOTOR_ON);
-                
-                if (current_mA > CUTOFF_STALL) {
-                    count = 0;
-                    state = FINISH;
-                }
-                
-                displayState();
+            handleLogMsg(span[i]);
+        }
+        core_link_release(n);
 
-                nextState = FINISH;
-                break;
+        if (mscEnabled) {
+            tud_task();
+        }
+
+        if (time_reached(nextFrame)) {
+            nextFrame = delayed_by_ms(nextFrame, 1000 / DISPLAY_HZ);
+            status_snapshot_t snap = core_link_snapshot();
+            // The WAIT state keeps the splash screen drawn by oled_init().
+            if (snap.state != WAIT) {
+                displayState(snap);
             }
         }
     }
-    return 0;
 }
 
+/**
+ * @brief Applies one message from core 0: writes a sample or performs a file/MSC command.
+ * @details Also tracks the consumer lag, i.e. how old a sample is by the time it reaches the file.
+ * @param msg The message.
+ */
+void handleLogMsg(const log_record_t& msg) {
+    static uint32_t maxLagUs = 0;
+
+    switch (msg.kind) {
+        case MSG_RECORD: {
+            maxLagUs = NTM_MAX(maxLagUs, time_us_32() - msg.time_us);
+#if LOG_CSV
+            char line[128];
+            fmt_t f;
+            fmt_init(&f, line, sizeof(line));
+            fmt_str(&f, (msg.state == CUTTING) ? "CUTTING" : "EXITING");
+            fmt_char(&f, ',');
+            fmt_uint(&f, msg.time_us / 1000);
+            const float values[] = {msg.current_mA.to_float(), msg.lp_current.to_float(), msg.maf_current.to_float(), msg.rpm,
+                                    msg.displacement.to_float(), msg.force.to_float()};
+            for (float v : values) {
+                fmt_char(&f, ',');
+                fmt_fixed(&f, v, 6);
+            }
+            fmt_char(&f, ',');
+            fmt_uint(&f, msg.pwm);
+            fmt_char(&f, '\n');
+            log_writer_write(line, f.len);
+#else
+            log_writer_write(&msg, sizeof(msg));
+#endif
+            break;
+        }
+        case MSG_OPEN_LOG:
+            maxLagUs = 0;
+            createDataFile();
+            break;
+        case MSG_CLOSE_LOG: {
+            log_writer_close();
+            log_writer_stats_t ws = log_writer_stats();
+            printf("log writer: %lu bytes in %lu chunks, max write %lu us, total %lu us, %lu errors, %s\n",
+                   (unsigned long)ws.bytes, (unsigned long)ws.chunks, (unsigned long)ws.max_write_us,
+                   (unsigned long)ws.total_write_us, (unsigned long)ws.errors, ws.contiguous ? "contiguous" : "fragmented");
+            f_close(&fil);
+            f_unmount("");
+            printf("log consumer lag: max %lu us\n", (unsigned long)maxLagUs);
+            printf("oled: %lu frames, %lu bus bytes saved, last frame %lu bytes\n", (unsigned long)oled.frames,
+                   (unsigned long)oled.saved_total, (unsigned long)oled.frame_bytes);
+            break;
+        }
+        case MSG_MSC_ON:
+            enableMSC();
+            break;
+        case MSG_MSC_OFF:
+            disableMSC();
+            break;
+    }
+}
+
+#pragma endregion
+
 #pragma region LOCAL DEFINITIONS
 
 /**
@@ -308,7 +496,7 @@ void oled_init() {
         ssd1306_draw_string(&oled, 0, 30, 1, "[ HOLD  STA  : ZERO ]");
         ssd1306_draw_string(&oled, 0, 45, 1, "V1.0 - 5/6/25");
         ssd1306_draw_string(&oled, 0, 55, 1, "Author: Thomas Chang");
-        displayBat(0);
+        displayBat(0, bat_per);
         ssd1306_show(&oled);
     } else {
         printf("OLED initialization failed.\n");
@@ -317,157 +505,201 @@ void oled_init() {
 
 /**
  * @brief Creates/writes datalog to the microSD via FatFS implementation.
- * Writes the header of the file if successful and names the file by order of creation.
+ * Writes the header of the file if successful and names the file by the run counter on the card (see run_index.h).
+ * @details The binary header records the schema of log_record_t, the state names, and the constants of this run so the
+ * file can be decoded without this firmware (see tools/runlog_convert). Runs on core 1, so the settings of the run come
+ * from core_link_run(), which core 0 published in hal_run_start().
  */
 void createDataFile() {
     
-    int fileNum = 0;
-    FRESULT file_created = f_open(&fil, filename, FA_CREATE_NEW | FA_WRITE);
-    while (file_created == FR_EXIST) {
-        fileNum++;
-        sprintf(filename, "data%d.csv", fileNum);
-        file_created = f_open(&fil, filename, FA_CREATE_NEW | FA_WRITE);
+    uint32_t runNum = 0;
+    FRESULT indexResult = FR_OK;
+    uint32_t openStart = time_us_32();
+    FRESULT file_created = run_index_open_next(&fil, LOG_EXT, &runNum, filename, sizeof(filename), &indexResult);
+    printf("log open: %s (%d) in %lu us\n", filename, file_created, (unsigned long)(time_us_32() - openStart));
+    if (indexResult != FR_OK) {
+        printf("log open: %s not updated (%d), run numbers may repeat\n", RUN_INDEX_FILE, indexResult);
+    }
+
+    if (log_writer_open(&fil) != FR_OK) {
+        printf("log writer: no contiguous space, logging without preallocation\n");
     }
 
+#if LOG_CSV
     // Print header of file
-    f_printf(&fil, "State, Time(ms), Current(mA), CurrentLP(mA), CurrentMAF(mA), RPM, Displacement(mm), Force(N)\n");
+    static const char header[] = "State, Time(ms), Current(mA), CurrentLP(mA), CurrentMAF(mA), RPM, Displacement(mm), Force(N), PWM\n";
+    log_writer_write(header, sizeof(header) - 1);
+#else
+    static const char* const stateNames[] = {"WAIT", "STANDBY", "CUTTING", "REMOVAL", "EXITING", "FINISH", "ZERO"};
+    run_settings_t run = core_link_run();
+    const runlog_param_t params[] = {
+        {"fwRev",       run.fw_rev},
+        {"bwRev",       run.bw_rev},
+        {"target_rpm",  run.target_rpm},
+        {"MAF_SZ",      (float)MAF_SZ},
+        {"LP_ALPHA",    LP_ALPHA},
+        {"FORCE_MED",   (float)FORCE_MED},
+        {"FORCE_ALPHA", FORCE_ALPHA},
+        {"RPM_Q",       RPM_Q},
+        {"RPM_R",       RPM_R},
+        {"CONTROL_HZ",  (float)CONTROL_HZ},
+        {"FORCE_HZ",    (float)FORCE_HZ},
+        {"INA_CONV_US", (float)ina219.conversion_us()},
+        {"STALL_VEL",   STALL_VEL_FRAC},
+        {"STALL_SLOPE", (float)STALL_SLOPE_MA_MS},
+        {"STALL_RISE",  (float)STALL_RISE_MA},
+        {"STALL_CONF",  (float)STALL_CONFIRM_US},
+        {"SPEED_HZ",    (float)SPEED_CTRL_HZ},
+        {"SPEED_KP",    SPEED_KP},
+        {"SPEED_KI",    SPEED_KI},
+        {"SPEED_KD",    SPEED_KD},
+        {"SPEED_KFF",   SPEED_KFF},
+        {"SPEED_FF0",   SPEED_FF0},
+        {"SPEED_SLEW",  SPEED_SLEW},
+        {"PROF_ACCEL",  PROFILE_ACCEL},
+        {"PROF_JERK",   PROFILE_JERK},
+        {"STOP_COAST",  run.stop_coast_ms},
+    };
+
+    runlog_info_t info;
+    info.run_number = (uint16_t)runNum;
+    info.sample_rate_hz = CURRENT_HZ;
+    info.state_names = stateNames;
+    info.state_count = sizeof(stateNames) / sizeof(stateNames[0]);
+    info.params = params;
+    info.param_count = sizeof(params) / sizeof(params[0]);
+
+    // Sized from the table, so adding a parameter grows the header instead of dropping it.
+    static uint8_t header[RUNLOG_HEADER_BYTES(sizeof(params) / sizeof(params[0]))];
+    static_assert(sizeof(header) <= UINT16_MAX, "run log header_size is 16 bits");
+    size_t headerSize = runlog_build_header(header, sizeof(header), &info);
+    if (headerSize == 0) {
+        printf("log header: does not fit in %u bytes, %s has no header\n", (unsigned)sizeof(header), filename);
+        return;
+    }
+    log_writer_write(header, headerSize);
+#endif
 }
 
 /**
  * @brief Helper function used to abstract how potentiometer input information is shown on the OLED screen
  * 
  * @param y_pos The y position in pixels (bottom left) of where the text is written.
+ * @param speed Selected speed in percent.
  */
-void displayInputSpeed(int y_pos) {
-    std::string temp = "INPUT SPEED: [ " + to_string(temp_speed) + "% ]";
-    const char* in_speed = temp.c_str();
+void displayInputSpeed(int y_pos, long speed) {
+    char in_speed[24];
+    fmt_t f;
+    fmt_init(&f, in_speed, sizeof(in_speed));
+    fmt_str(&f, "INPUT SPEED: [ ");
+    fmt_int(&f, speed);
+    fmt_str(&f, "% ]");
     ssd1306_draw_string(&oled, 0, y_pos, 1, in_speed);
 }
 
 /**
  * @brief Handles the order of information, titles, and instructions shown on the OLED display by state in FSM.
- * 
+ * @details Runs on core 1 and only reads the published snapshot. The frame is queued on the I2C DMA engine; if the
+ * previous frame is still being sent this one is skipped so the buffer is never changed mid transfer.
+ * @param snap Latest values published by core 0.
  */
-void displayState() {
+void displayState(const status_snapshot_t& snap) {
+    if (ssd1306_busy(&oled)) {
+        return;
+    }
     ssd1306_clear(&oled);
-    switch(state) {
+    switch(snap.state) {
             case STANDBY:
                 ssd1306_draw_string(&oled, 0, 2, 2, "STANDBY");
                 ssd1306_draw_string(&oled, 0, 20, 1, "[ PRESS STA  :  NEW ]");
                 ssd1306_draw_string(&oled, 0, 30, 1, "[ PRESS MSC  : LOGS ]");
-                displayBat(0);
-                displayInputSpeed(50);
+                displayBat(0, snap.bat_per);
+                displayInputSpeed(50, snap.temp_speed);
                 break;
             
             case CUTTING:
                 ssd1306_draw_string(&oled, 0, 2, 2, "CUTTING");
-                displayBat(0);
-                displayData(&oled, 20, current_mA, "CUR (mA)  : ");
-                displayData(&oled, 30, rpm, "SPD (RPM) : ");
-                displayData(&oled, 40, displacement, "POS (mm)  : ");
-                displayData(&oled, 50, force, "FRC (N)   : ");
+                displayBat(0, snap.bat_per);
+                displayData(&oled, 20, snap.current_mA.to_float(), "CUR (mA)  : ");
+                displayData(&oled, 30, snap.rpm, "SPD (RPM) : ");
+                displayData(&oled, 40, snap.displacement.to_float(), "POS (mm)  : ");
+                displayData(&oled, 50, snap.force.to_float(), "FRC (N)   : ");
                 break;
             
             case REMOVAL:
                 ssd1306_draw_string(&oled, 0, 2, 2, "REMOVAL");
-                displayBat(0);
-                displayData(&oled, 20, displacement, "POS (mm)  : ");
-                displayInputSpeed(50);
+                displayBat(0, snap.bat_per);
+                displayData(&oled, 20, snap.displacement.to_float(), "POS (mm)  : ");
+                displayInputSpeed(50, snap.temp_speed);
                 break;
             
             case EXITING:
                 ssd1306_draw_string(&oled, 0, 2, 2, "EXITING");
-                displayBat(0);
-                displayData(&oled, 20, current_mA, "CUR (mA)  : ");
-                displayData(&oled, 30, rpm, "SPD (RPM) : ");
-                displayData(&oled, 40, displacement, "POS (mm)  : ");
-                displayData(&oled, 50, force, "FRC (N)   : ");
+                displayBat(0, snap.bat_per);
+                displayData(&oled, 20, snap.current_mA.to_float(), "CUR (mA)  : ");
+                displayData(&oled, 30, snap.rpm, "SPD (RPM) : ");
+                displayData(&oled, 40, snap.displacement.to_float(), "POS (mm)  : ");
+                displayData(&oled, 50, snap.force.to_float(), "FRC (N)   : ");
                 break;
             
             case FINISH: // For debugging purposes.
                 ssd1306_draw_string(&oled, 0, 2, 2, "COMPLETE");
-                displayBat(0);
+                displayBat(0, snap.bat_per);
                 ssd1306_draw_string(&oled, 0, 20, 1, "[ PRESS STA  :  NEW ]");
                 ssd1306_draw_string(&oled, 0, 30, 1, "[ PRESS MSC  : LOGS ]");
                 break;
             case ZERO:
                 ssd1306_draw_string(&oled, 0, 2, 2, "ZERO");
-                displayBat(0);
+                displayBat(0, snap.bat_per);
                 ssd1306_draw_string(&oled, 0, 20, 1, "Resetting to origin");
-                displayData(&oled, 30, current_mA, "CUR (mA)  : ");
+                displayData(&oled, 30, snap.current_mA.to_float(), "CUR (mA)  : ");
                 break;
         }
-    ssd1306_show(&oled);
+    ssd1306_show_async(&oled);
 }
 
 /**
  * @brief Helper function used to display calculated battery capacity value on OLED.
  * @details When below the 0 threshold, will display LO on the screen. Automatically adjusts depending on if 3 digits are required.
  * @param y_pos The y position in pixels (bottom left) of where the text is written.
+ * @param bat Battery capacity in percent.
  */
-void displayBat(int y_pos) {
-    std::string temp = to_string(bat_per) + "%";
+void displayBat(int y_pos, long bat) {
+    char bat_str[8];
+    fmt_t f;
+    fmt_init(&f, bat_str, sizeof(bat_str));
+    fmt_int(&f, bat);
+    fmt_char(&f, '%');
     int x_pos = 110;
-    if (bat_per == 0) {
+    if (bat == 0) {
         ssd1306_draw_string(&oled, 110, y_pos, 1, "BAT");
         ssd1306_draw_string(&oled, 116, y_pos + 8, 1, "LO");
         return;
-    } else if (bat_per < 10) {
+    } else if (bat < 10) {
         x_pos = 116;
     }
-    const char* bat = temp.c_str();
     ssd1306_draw_string(&oled, 110, y_pos, 1, "BAT");
-    ssd1306_draw_string(&oled, x_pos, y_pos + 8, 1, bat);
+    ssd1306_draw_string(&oled, x_pos, y_pos + 8, 1, bat_str);
 }
 
 /**
  * @brief Calculates the current capacity of the battery using predetermined minimum and maximum charge values.
  * 
- * @details Relies on ADC averaging and makes calculations based on battery voltage.
- * @return float 
+ * @details Uses the latest average from the ADC sampler (see adc_sampler.h) and makes calculations based on battery voltage.
+ * @return long 
  */
-float getBatLevel() {
-    adc_select_input(0);
-    long bat = adc_read();
-    for (int i = 0; i < potIterations; i++) {
-        bat += adc_read();
-    }
-    bat /= 1.0 * potIterations;
-    bat = NTM_MAX(bat, BAT_MIN_ADC);
-    bat = NTM_MIN(bat, BAT_MAX_ADC);
-    bat = (bat - BAT_MIN_ADC) * BAT_ADC_PER;
-    return bat;
+long getBatLevel() {
+    return batteryPercent(adc_sampler_read(BAT_ADC_INPUT)).to_int();
 }
 
 /**
  * @brief Calculates the percentage power represented by the inputted ADC value from the potentiometer.
  * 
+ * @details Uses the latest average from the ADC sampler (see adc_sampler.h).
  * @return long 
  */
 long getInputSpeed() {
-    adc_select_input(3);
-    long val = 0;
-    for (int i = 0; i < potIterations; i++) {
-        val += adc_read();
-    }
-    
-    return long(0.0243 * (val * 1.0 / potIterations) + 1);
-}
-
-/**
- * @brief Uses a 1 second timer to extrapolate the revolutions per minute.
- * @details Determines the number of revolutions that occur within a second and multiplies it by 60.
- * 
- */
-void getRPM() {
-    static absolute_time_t prevRPMTime = get_absolute_time();
-    absolute_time_t currRPMTime = get_absolute_time();
-
-    if (absolute_time_diff_us(prevRPMTime, currRPMTime) >= SEC_US) {
-        rpm = getRevolutions(numPulses) * 60.0f;
-        numPulses = 0;
-        prevRPMTime = currRPMTime;
-    }
+    return potToSpeed(adc_sampler_read(SPEED_ADC_INPUT)).to_int();
 }
 
 bool validPress = false;
@@ -484,12 +716,7 @@ void handleButton() {
 
         if (validPress) {
             if (absolute_time_diff_us(pressTime, now) >= hold_us) {
-                state = ZERO;
-                nextState = FINISH;
-                gpio_put(MOTOR_DIR, 0);
-                pwm_set_chan_level(slice, channel, 255);
-                displayState();
-                sleep_ms(SPIKE_TIME);
+                control_hold();
 
                 button_press_flag = false;
                 validPress = false;
@@ -501,10 +728,7 @@ void handleButton() {
 void handleRelease() {
     if (button_release_flag) {
         if (validPress) {
-            state = nextState;
-            if (state == CUTTING) {
-                createDataFile();
-            }
+            control_release();
             validPress = false;
         }
         button_release_flag = false;
@@ -524,16 +748,6 @@ void handleMSCButton() {
     }
 }
 
-void resetFiltering() {
-    // Initialize all moving average filter values to zero.
-    MAF_counter = 0;
-    MAF_sum = 0;
-    memset(MAF, 0, sizeof(MAF));
-
-    // Reset previous low pass output.
-    lp_current = 0;
-}
-
 void enableMSC() {
     f_unmount("");
     tud_task();
@@ -571,8 +785,8 @@ void testingSuite() {
     gpio_pull_down(msc_input);
 
     // POTENTIOMETER
-    adc_init();
     adc_gpio_init(speed_input);
+    adc_sampler_init(1u << SPEED_ADC_INPUT, ADC_SAMPLE_HZ);
 
     // Motor Control
     uint slice = pwm_gpio_to_slice_num(MOTOR_PWM);
@@ -592,6 +806,7 @@ void testingSuite() {
         }
         
         // Testing potentiometer.
+        adc_sampler_update();
         long test_pot = getInputSpeed() * 10;
         gpio_put(26, 1);
         sleep_ms(test_pot);
@@ -621,8 +836,10 @@ void testMSC() {
     gpio_pull_up(I2C_SCL);
 
     uint32_t sys_freq = clock_get_hz(clk_sys);
-    std::string temp = to_string(sys_freq);
-    const char* sys_freq_str = temp.c_str();
+    char sys_freq_str[12];
+    fmt_t f;
+    fmt_init(&f, sys_freq_str, sizeof(sys_freq_str));
+    fmt_uint(&f, sys_freq);
     oled.external_vcc = false;
     bool oled_status = ssd1306_init(&oled, 128, 64, OLED_ADDR, MY_I2C);
     
@@ -0,0 +1,76 @@
+/**
+ * @file motion_profile.cpp
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the jerk limited motion profile.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "include/motion_profile.h"
+
+#include <math.h>
+
+void motion_profile_init(motion_profile_t* p, const motion_profile_config_t* cfg) {
+    p->cfg = *cfg;
+    p->active = false;
+    p->forward = true;
+    p->target = 0.0f;
+    p->v_max = 0.0f;
+    p->v = 0.0f;
+    p->a = 0.0f;
+}
+
+void motion_profile_start(motion_profile_t* p, float from_rev, float to_rev, float max_rpm) {
+    p->active = (max_rpm > 0.0f);
+    p->forward = (to_rev >= from_rev);
+    p->target = to_rev;
+    p->v_max = max_rpm / 60.0f;
+    p->v = 0.0f;
+    p->a = 0.0f;
+}
+
+float motion_profile_update(motion_profile_t* p, float pos_rev, float dt) {
+    if (!p->active) {
+        return 0.0f;
+    }
+    float remaining = p->forward ? p->target - pos_rev : pos_rev - p->target;
+    if (remaining <= p->cfg.tol_rev) {
+        motion_profile_stop(p);
+        return 0.0f;
+    }
+
+    const float accel = p->cfg.accel / 60.0f;
+    const float jerk = p->cfg.jerk / 60.0f;
+
+    // Speed from which the needle can still stop at the target. The deceleration needs accel / jerk to ramp in, during
+    // which about half of that time is spent at the current speed.
+    float brake = remaining - p->v * (accel / jerk) * 0.5f;
+    float v_goal = (brake > 0.0f) ? sqrtf(2.0f * accel * brake) : 0.0f;
+    v_goal = fminf(v_goal, p->v_max);
+    v_goal = fmaxf(v_goal, p->cfg.min_rpm / 60.0f);
+
+    // Head for the goal with the acceleration it can still take back in time at the jerk limit.
+    float dv = v_goal - p->v;
+    float a_goal = fminf(accel, sqrtf(2.0f * jerk * fabsf(dv)));
+    a_goal = (dv < 0.0f) ? -a_goal : a_goal;
+    float step = jerk * dt;
+    p->a += fmaxf(-step, fminf(step, a_goal - p->a));
+
+    // Do not step over the goal because of the tick length.
+    float v = p->v + p->a * dt;
+    if ((dv > 0.0f && v > v_goal) || (dv < 0.0f && v < v_goal)) {
+        v = v_goal;
+        p->a = 0.0f;
+    }
+    p->v = fmaxf(v, 0.0f);
+    return p->v * 60.0f;
+}
+
+void motion_profile_stop(motion_profile_t* p) {
+    p->active = false;
+    p->v = 0.0f;
+    p->a = 0.0f;
+}
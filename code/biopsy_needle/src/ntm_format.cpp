@@ -0,0 +1,164 @@
+/**
+ * @file ntm_format.cpp
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the allocation-free text formatter.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "include/ntm_format.h"
+
+#include <string.h>
+
+static const uint32_t pow10_table[FMT_MAX_DECIMALS + 1] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000, 1000000000
+};
+
+/**
+ * @brief Writes the decimal digits of v, right aligned, ending just before end.
+ *
+ * @param end One past the last digit.
+ * @param v Value.
+ * @param min_digits Leading zeros are added up to this many digits.
+ * @return char* First digit written.
+ */
+static char* put_digits(char* end, uint32_t v, uint8_t min_digits) {
+    uint8_t n = 0;
+    do {
+        *--end = (char)('0' + v % 10);
+        v /= 10;
+        n++;
+    } while (v != 0 || n < min_digits);
+    return end;
+}
+
+/**
+ * @brief Appends len characters from s after padding to width.
+ *
+ */
+static void put_padded(fmt_t* f, const char* s, size_t len, uint8_t width, char pad) {
+    for (size_t i = len; i < width; i++) {
+        fmt_char(f, pad);
+    }
+    for (size_t i = 0; i < len; i++) {
+        fmt_char(f, s[i]);
+    }
+}
+
+void fmt_init(fmt_t* f, char* buf, size_t cap) {
+    f->buf = buf;
+    f->cap = cap;
+    f->len = 0;
+    buf[0] = '\0';
+}
+
+void fmt_char(fmt_t* f, char c) {
+    if (f->len + 1 < f->cap) {
+        f->buf[f->len++] = c;
+        f->buf[f->len] = '\0';
+    }
+}
+
+void fmt_str(fmt_t* f, const char* s) {
+    while (*s) {
+        fmt_char(f, *s++);
+    }
+}
+
+void fmt_uint(fmt_t* f, uint32_t v, uint8_t width, char pad) {
+    char tmp[10];
+    char* start = put_digits(tmp + sizeof(tmp), v, 1);
+    put_padded(f, start, tmp + sizeof(tmp) - start, width, pad);
+}
+
+void fmt_int(fmt_t* f, int32_t v, uint8_t width, char pad) {
+    char tmp[11];
+    uint32_t mag = (v < 0) ? 0u - (uint32_t)v : (uint32_t)v;
+    char* start = put_digits(tmp + sizeof(tmp), mag, 1);
+    size_t len = tmp + sizeof(tmp) - start;
+
+    if (v < 0 && pad == '0') {
+        fmt_char(f, '-');
+        put_padded(f, start, len, width ? width - 1 : 0, '0');
+        return;
+    }
+    if (v < 0) {
+        *--start = '-';
+        len++;
+    }
+    put_padded(f, start, len, width, pad);
+}
+
+void fmt_fixed(fmt_t* f, float v, uint8_t decimals, uint8_t width) {
+    if (decimals > FMT_MAX_DECIMALS) {
+        decimals = FMT_MAX_DECIMALS;
+    }
+    if (v != v) {
+        put_padded(f, "nan", 3, width, ' ');
+        return;
+    }
+
+    bool neg = v < 0;
+    if (neg) {
+        v = -v;
+    }
+    if (v >= 4294967296.0f) {
+        put_padded(f, "ovf", 3, width, ' ');
+        return;
+    }
+
+    // Work on the exact binary value v = m * 2^e, so rounding is decided by integer arithmetic and not by a float
+    // multiply that rounds on its own.
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    uint32_t m = bits & 0x7FFFFF;
+    int32_t e = (int32_t)((bits >> 23) & 0xFF);
+    if (e == 0) {
+        e = -149;
+    } else {
+        m |= 0x800000;
+        e -= 150;
+    }
+
+    uint32_t ip;
+    uint64_t frac;
+    uint32_t k;     // frac is a fraction over 2^k
+    if (e >= 0) {
+        ip = m << e;
+        frac = 0;
+        k = 1;
+    } else {
+        k = (uint32_t)(-e);
+        ip = (k < 32) ? (m >> k) : 0;
+        frac = (k < 32) ? (m & ((1u << k) - 1)) : m;
+        // frac < 2^24, so frac * 10^9 plus the rounding half fits 64 bits for any k up to 63. Past that v < 2^-39,
+        // which rounds to 0 at FMT_MAX_DECIMALS, and shifting by k would overflow.
+        if (k > 63) {
+            frac = 0;
+            k = 63;
+        }
+    }
+
+    uint32_t scale = pow10_table[decimals];
+    uint32_t fp = (uint32_t)((frac * scale + (1ull << (k - 1))) >> k);
+    if (fp >= scale) {
+        fp -= scale;
+        ip++;
+    }
+
+    char tmp[1 + 10 + 1 + FMT_MAX_DECIMALS];
+    char* end = tmp + sizeof(tmp);
+    char* start = end;
+    if (decimals) {
+        start = put_digits(end, fp, decimals);
+        *--start = '.';
+    }
+    start = put_digits(start, ip, 1);
+    if (neg && (ip || fp)) {
+        *--start = '-';
+    }
+    put_padded(f, start, end - start, width, ' ');
+}
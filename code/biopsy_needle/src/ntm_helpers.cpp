@@ -10,6 +10,8 @@
  */
 
 #include "include/ntm_helpers.h"
+#include "include/ntm_format.h"
+#include "include/adc_sampler.h"
 
 /**
  * @brief Global slice value for the PWM module. Automatically determined by chosen pin at runtime. Corresponds to the organization of PWM configurations by clock. Please see RP2040 documentation.
@@ -23,11 +25,24 @@ uint slice =  pwm_gpio_to_slice_num(MOTOR_PWM);
  */
 uint channel = pwm_gpio_to_channel(MOTOR_PWM);
 
-void board_gpio_init() {
-    // Potentiometer Input
-    adc_init();
+/**
+ * @brief Global quadrature decoder counting both motor encoder channels in PIO.
+ * 
+ */
+quad_encoder_t encoder;
+
+/**
+ * @brief Last direction and PWM level commanded through setMotor().
+ * 
+ */
+bool motorDir = MOTOR_FW;
+uint16_t motorPower = MOTOR_OFF;
+
+bool board_gpio_init() {
+    // Potentiometer and Battery Input
     adc_gpio_init(speed_input);
     adc_gpio_init(bat_lvl);
+    adc_sampler_init((1u << BAT_ADC_INPUT) | (1u << SPEED_ADC_INPUT), ADC_SAMPLE_HZ);
 
     // Pushbutton State Input
     gpio_init(state_input);
@@ -48,13 +63,9 @@ void board_gpio_init() {
     gpio_init(MOTOR_DIR);
     gpio_set_dir(MOTOR_DIR, GPIO_OUT);
 
-    // Motor Feedback - Output Signals
-    gpio_init(motorA_out);
-    gpio_set_dir(motorA_out, GPIO_IN);
-    gpio_pull_up(motorA_out);
-    gpio_init(motorB_out);
-    gpio_set_dir(motorB_out, GPIO_IN);
-    gpio_pull_up(motorB_out);
+    // Motor Feedback - Encoder Channels A and B
+    bool encoderOk = quad_encoder_init(&encoder, ENCODER_PIO, ENCODER_PIN_BASE) &&
+                     quad_encoder_init_timing(&encoder, ENCODER_TIME_PIO, motorA_out, ENCODER_ZERO_US);
     
     // I2C Initialization
     i2c_init(MY_I2C, 400000);
@@ -62,21 +73,30 @@ void board_gpio_init() {
     gpio_set_function(I2C_SCL, GPIO_FUNC_I2C);
     gpio_pull_up(I2C_SDA);
     gpio_pull_up(I2C_SCL);
+
+    // All run time transfers on the shared bus go through the DMA engine, which also serializes the two cores.
+    i2c_dma_init(MY_I2C, I2C_SDA, I2C_SCL);
+    return encoderOk;
 }
 
 void setMotor(bool direction, uint16_t power) {
     gpio_put(MOTOR_DIR, direction);
     pwm_set_chan_level(slice, channel, power);
+    motorDir = direction;
+    motorPower = power;
 }
 
-void displayData(ssd1306_t* screen, int y_pos, float data, std::string info) {
-    std::string temp = info + std::to_string(data);
-    const char* data_formatted = temp.c_str();
-    ssd1306_draw_string(screen, 0, y_pos, 1, data_formatted);
+void __not_in_flash_func(motorOff)() {
+    pwm_set_chan_level(slice, channel, MOTOR_OFF);
+    motorPower = MOTOR_OFF;
 }
 
-float getRevolutions(int count) {
-    float re = count/12.0/34.014f;
-    return re;
+void displayData(ssd1306_t* screen, int y_pos, float data, const char* info, uint8_t decimals) {
+    char text[32];
+    fmt_t f;
+    fmt_init(&f, text, sizeof(text));
+    fmt_str(&f, info);
+    fmt_fixed(&f, data, decimals);
+    ssd1306_draw_string(screen, 0, y_pos, 1, text);
 }
 
@@ -0,0 +1,115 @@
+/**
+ * @file run_index.cpp
+ * @author Thomas Chang
+ * @brief This file holds the definitions for allocating run log files from the on-card run counter.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "include/run_index.h"
+
+#include <stdio.h>
+#include <string.h>
+
+/**
+ * @brief Reads the next run number and stores the one after it.
+ * @details The counter is stored with its complement so a torn or foreign file is detected; a missing or damaged
+ * counter reads as 0.
+ * @param run Set to the reserved run number, 0 if the index could not be opened.
+ * @return FRESULT of the first index operation that failed, FR_OK if the counter was advanced.
+ */
+static FRESULT reserve_run(uint32_t* run) {
+    FIL idx;
+    uint32_t rec[2] = {0, 0};
+    UINT n = 0;
+
+    *run = 0;
+    FRESULT fr = f_open(&idx, RUN_INDEX_FILE, FA_OPEN_ALWAYS | FA_READ | FA_WRITE);
+    if (fr != FR_OK) {
+        return fr;
+    }
+    fr = f_read(&idx, rec, sizeof(rec), &n);
+    if (fr == FR_OK && n == sizeof(rec) && rec[1] == ~rec[0]) {
+        *run = rec[0];
+    }
+
+    rec[0] = *run + 1;
+    rec[1] = ~rec[0];
+    if (fr == FR_OK) {
+        fr = f_lseek(&idx, 0);
+    }
+    if (fr == FR_OK) {
+        fr = f_write(&idx, rec, sizeof(rec), &n);
+        if (fr == FR_OK && n != sizeof(rec)) {
+            fr = FR_DENIED;     // card full
+        }
+    }
+    FRESULT closed = f_close(&idx);
+    return fr != FR_OK ? fr : closed;
+}
+
+/**
+ * @brief Overwrites the counter after runs already on the card were skipped.
+ *
+ * @param next Next run number to hand out.
+ * @return FRESULT
+ */
+static FRESULT store_run(uint32_t next) {
+    FIL idx;
+    uint32_t rec[2] = {next, ~next};
+    UINT n = 0;
+
+    FRESULT fr = f_open(&idx, RUN_INDEX_FILE, FA_OPEN_ALWAYS | FA_WRITE);
+    if (fr != FR_OK) {
+        return fr;
+    }
+    fr = f_write(&idx, rec, sizeof(rec), &n);
+    if (fr == FR_OK && n != sizeof(rec)) {
+        fr = FR_DENIED;
+    }
+    FRESULT closed = f_close(&idx);
+    return fr != FR_OK ? fr : closed;
+}
+
+static void run_path(char* path, size_t path_len, uint32_t run, const char* ext) {
+    snprintf(path, path_len, "runs%03lu/data%lu.%s", (unsigned long)(run / RUNS_PER_DIR), (unsigned long)run, ext);
+}
+
+static FRESULT create(FIL* fil, char* path) {
+    FRESULT fr = f_open(fil, path, FA_CREATE_NEW | FA_WRITE);
+    if (fr == FR_NO_PATH) {
+        // First run of a group. Create its directory.
+        char* slash = strchr(path, '/');
+        *slash = '\0';
+        f_mkdir(path);
+        *slash = '/';
+        fr = f_open(fil, path, FA_CREATE_NEW | FA_WRITE);
+    }
+    return fr;
+}
+
+FRESULT run_index_open_next(FIL* fil, const char* ext, uint32_t* run, char* path, size_t path_len,
+                            FRESULT* index_fr) {
+    *index_fr = reserve_run(run);
+    run_path(path, path_len, *run, ext);
+    FRESULT fr = create(fil, path);
+
+    // Only after the index was lost or could not be written: step over the runs already on the card. The number is
+    // advanced here rather than re-read, so an index that cannot be updated does not return the same path forever.
+    uint32_t skipped = 0;
+    while (fr == FR_EXIST && skipped < RUN_INDEX_MAX_SKIP) {
+        (*run)++;
+        skipped++;
+        run_path(path, path_len, *run, ext);
+        fr = create(fil, path);
+    }
+
+    // Resynchronize the counter once, past the file just created.
+    if (skipped > 0 && fr == FR_OK && *index_fr == FR_OK) {
+        *index_fr = store_run(*run + 1);
+    }
+    return fr;
+}
@@ -0,0 +1,71 @@
+/**
+ * @file runlog.cpp
+ * @author Thomas Chang
+ * @brief This file holds the definitions for building the binary run log header.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "include/runlog.h"
+#include "include/core_link.h"
+#include "include/config.h"
+
+#include <string.h>
+
+#define CHANNEL_SCALED(name, unit, type, field, role, scale) \
+    { name, unit, type, (uint8_t)offsetof(log_record_t, field), role, 0, scale }
+#define CHANNEL(name, unit, type, field, role) CHANNEL_SCALED(name, unit, type, field, role, 1.0f)
+#define CHANNEL_Q16(name, unit, field) CHANNEL_SCALED(name, unit, RUNLOG_I32, field, RUNLOG_ROLE_DATA, 1.0f / 65536)
+
+/// Schema of log_record_t. Order matches the columns of the CSV build.
+static const runlog_channel_t record_channels[] = {
+    CHANNEL("State",        "",   RUNLOG_U8,  state,        RUNLOG_ROLE_STATE),
+    CHANNEL("Time",         "us", RUNLOG_U32, time_us,      RUNLOG_ROLE_TIME_US),
+    CHANNEL_Q16("Current",      "mA", current_mA),
+    CHANNEL_Q16("CurrentLP",    "mA", lp_current),
+    CHANNEL_Q16("CurrentMAF",   "mA", maf_current),
+    CHANNEL("RPM",          "",   RUNLOG_F32, rpm,          RUNLOG_ROLE_DATA),
+    CHANNEL_Q16("Displacement", "mm", displacement),
+    CHANNEL_Q16("Force",        "N",  force),
+    CHANNEL("PWM",          "",   RUNLOG_U16, pwm,          RUNLOG_ROLE_DATA),
+};
+
+#define NUM_CHANNELS (sizeof(record_channels) / sizeof(record_channels[0]))
+static_assert(NUM_CHANNELS == RUNLOG_RECORD_CHANNELS, "update RUNLOG_RECORD_CHANNELS with record_channels");
+
+size_t runlog_build_header(uint8_t* buf, size_t cap, const runlog_info_t* info) {
+    size_t used = sizeof(runlog_header_t) + sizeof(record_channels) + info->param_count * sizeof(runlog_param_t);
+    size_t total = (used + RUNLOG_ALIGN - 1) / RUNLOG_ALIGN * RUNLOG_ALIGN;
+    if (total > cap || total > UINT16_MAX) {
+        return 0;
+    }
+    memset(buf, 0, total);
+
+    runlog_header_t hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    memcpy(hdr.magic, RUNLOG_MAGIC, sizeof(RUNLOG_MAGIC));
+    hdr.version = RUNLOG_VERSION;
+    hdr.header_size = (uint16_t)total;
+    hdr.record_size = sizeof(log_record_t);
+    hdr.channel_count = NUM_CHANNELS;
+    hdr.param_count = info->param_count;
+    hdr.run_number = info->run_number;
+    hdr.sample_rate_hz = info->sample_rate_hz;
+    strncpy(hdr.firmware_rev, FW_VERSION "-" FW_GIT_REV, RUNLOG_REV_LEN - 1);
+    for (uint8_t i = 0; i < info->state_count && i < RUNLOG_MAX_STATES; i++) {
+        strncpy(hdr.state_names[i], info->state_names[i], RUNLOG_STATE_LEN - 1);
+    }
+
+    // The RP2040 is little-endian, so the packed structs are already in file order.
+    uint8_t* p = buf;
+    memcpy(p, &hdr, sizeof(hdr));
+    p += sizeof(hdr);
+    memcpy(p, record_channels, sizeof(record_channels));
+    p += sizeof(record_channels);
+    memcpy(p, info->params, info->param_count * sizeof(runlog_param_t));
+
+    return total;
+}
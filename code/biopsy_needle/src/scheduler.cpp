@@ -0,0 +1,144 @@
+/**
+ * @file scheduler.cpp
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the timer-driven rate-group scheduler.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "include/scheduler.h"
+#include "include/config.h"
+
+#include <stdio.h>
+#include "hardware/sync.h"
+
+static sched_task_t tasks[SCHED_MAX_TASKS];
+static int run_order[SCHED_MAX_TASKS];     ///< Task ids sorted fastest rate group first.
+static int num_tasks = 0;
+
+static alarm_pool_t* sched_pool = NULL;
+static repeating_timer_t sched_timer;
+static volatile uint32_t sched_tick = 0;
+static uint64_t sched_start_us = 0;
+
+#define SCHED_PERIOD_US (1000000 / SCHED_BASE_HZ)
+
+/**
+ * @brief Base tick callback. Runs in the alarm IRQ, so it only marks tasks as released.
+ *
+ */
+static bool scheduler_tick(repeating_timer_t* rt) {
+    uint32_t tick = ++sched_tick;
+    uint64_t ideal_us = sched_start_us + (uint64_t)tick * SCHED_PERIOD_US;
+
+    for (int i = 0; i < num_tasks; i++) {
+        sched_task_t* t = &tasks[i];
+        if (tick % t->divider != t->phase) {
+            continue;
+        }
+        if (t->pending) {
+            t->overruns++;
+        }
+        t->release_us = ideal_us;
+        t->pending = true;
+    }
+    return true;
+}
+
+int scheduler_add_task(const char* name, uint32_t rate_hz, sched_task_fn fn) {
+    if (num_tasks >= SCHED_MAX_TASKS || rate_hz == 0 || rate_hz > SCHED_BASE_HZ || SCHED_BASE_HZ % rate_hz != 0) {
+        return -1;
+    }
+
+    int id = num_tasks;
+    sched_task_t* t = &tasks[id];
+    t->name = name;
+    t->fn = fn;
+    t->divider = SCHED_BASE_HZ / rate_hz;
+    // Offset each new group by one tick so slow groups do not all land on the same tick.
+    t->phase = id % t->divider;
+    t->pending = false;
+
+    // Insert into the run order so faster groups always run first.
+    int pos = num_tasks;
+    while (pos > 0 && tasks[run_order[pos - 1]].divider > t->divider) {
+        run_order[pos] = run_order[pos - 1];
+        pos--;
+    }
+    run_order[pos] = id;
+    num_tasks++;
+
+    scheduler_reset_stats();
+    return id;
+}
+
+bool scheduler_start() {
+    if (sched_pool == NULL) {
+        // A private pool keeps the base tick away from sleep_ms() and other users of the default alarm pool.
+        sched_pool = alarm_pool_create_with_unused_hardware_alarm(2);
+    }
+    sched_tick = 0;
+    sched_start_us = time_us_64();
+
+    // Negative delay means the period is measured between ideal release times, not callback completions.
+    return alarm_pool_add_repeating_timer_us(sched_pool, -(int64_t)SCHED_PERIOD_US, scheduler_tick, NULL, &sched_timer);
+}
+
+int scheduler_run_pending() {
+    int executed = 0;
+    for (int i = 0; i < num_tasks; i++) {
+        sched_task_t* t = &tasks[run_order[i]];
+        if (!t->pending) {
+            continue;
+        }
+
+        // Release time is 64 bits wide and written from the alarm IRQ, so read it atomically.
+        uint32_t irq_state = save_and_disable_interrupts();
+        uint64_t release_us = t->release_us;
+        t->pending = false;
+        restore_interrupts(irq_state);
+
+        uint64_t start_us = time_us_64();
+        t->fn(release_us);
+        uint64_t end_us = time_us_64();
+
+        t->last_jitter_us = (uint32_t)(start_us - release_us);
+        t->last_exec_us = (uint32_t)(end_us - start_us);
+        t->max_jitter_us = NTM_MAX(t->max_jitter_us, t->last_jitter_us);
+        t->max_exec_us = NTM_MAX(t->max_exec_us, t->last_exec_us);
+        t->runs++;
+        executed++;
+    }
+    return executed;
+}
+
+const sched_task_t* scheduler_get_task(int id) {
+    if (id < 0 || id >= num_tasks) {
+        return NULL;
+    }
+    return &tasks[id];
+}
+
+void scheduler_reset_stats() {
+    for (int i = 0; i < num_tasks; i++) {
+        tasks[i].runs = 0;
+        tasks[i].overruns = 0;
+        tasks[i].last_jitter_us = 0;
+        tasks[i].max_jitter_us = 0;
+        tasks[i].last_exec_us = 0;
+        tasks[i].max_exec_us = 0;
+    }
+}
+
+void scheduler_print_stats() {
+    printf("%-10s %6s %8s %8s %10s %10s\n", "TASK", "HZ", "RUNS", "OVERRUN", "JIT_MAX_US", "EXE_MAX_US");
+    for (int i = 0; i < num_tasks; i++) {
+        const sched_task_t* t = &tasks[run_order[i]];
+        printf("%-10s %6lu %8lu %8lu %10lu %10lu\n", t->name, (unsigned long)(SCHED_BASE_HZ / t->divider),
+               (unsigned long)t->runs, (unsigned long)t->overruns, (unsigned long)t->max_jitter_us,
+               (unsigned long)t->max_exec_us);
+    }
+}
@@ -0,0 +1,146 @@
+/**
+ * @file speed_control.cpp
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the closed-loop motor speed controller.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "include/speed_control.h"
+#include "include/speed_hal.h"
+#include "include/ntm_helpers.h"
+
+#include "hardware/sync.h"
+
+#define SPEED_CTRL_PERIOD_US    (1000000 / SPEED_CTRL_HZ)
+
+static alarm_pool_t* ctrl_pool = NULL;
+static repeating_timer_t ctrl_timer;
+static quad_encoder_t* enc = NULL;
+static speed_loop_t loop;
+static uint32_t last_exec_us = 0;
+
+// ==== Platform of the speed loop (speed_hal.h) ==== //
+float speed_hal_velocity(uint32_t now_us) {
+    return ENCODER_SIGN * quad_encoder_update_velocity(enc, now_us);
+}
+
+int32_t speed_hal_position() {
+    return ENCODER_SIGN * quad_encoder_last(enc);
+}
+
+void speed_hal_zero() {
+    quad_encoder_zero_last(enc);
+}
+
+void speed_hal_arm_limit(int32_t position, int32_t limit, bool increasing) {
+    quad_encoder_arm_limit(enc, position, limit, increasing);
+}
+
+void speed_hal_disarm_limit() {
+    quad_encoder_disarm_limit(enc);
+}
+
+void speed_hal_motor(bool direction, uint16_t pwm) {
+    setMotor(direction, pwm);
+}
+
+uint32_t speed_hal_lock() {
+    return save_and_disable_interrupts();
+}
+
+void speed_hal_unlock(uint32_t state) {
+    restore_interrupts(state);
+}
+
+/**
+ * @brief Hard limit reached. Runs in the PIO IRQ, which preempts the control loop.
+ *
+ */
+static void __not_in_flash_func(limit_trip)(void) {
+    motorOff();
+    speed_loop_trip(&loop);
+}
+
+/**
+ * @brief Control loop tick. Runs in the alarm IRQ.
+ *
+ */
+static bool speed_control_tick(repeating_timer_t* rt) {
+    uint32_t start = time_us_32();
+    speed_loop_tick(&loop, start, last_exec_us * 1e-6f);
+    last_exec_us = time_us_32() - start;
+    loop.stats.max_exec_us = NTM_MAX(loop.stats.max_exec_us, last_exec_us);
+    return true;
+}
+
+bool speed_control_start(quad_encoder_t* e, const speed_pid_config_t* cfg, const stop_config_t* stop_cfg) {
+    enc = e;
+    speed_loop_init(&loop, cfg, stop_cfg);
+    if (!quad_encoder_init_limit(enc, ENCODER_LIMIT_PIO, motorA_out, limit_trip)) {
+        return false;       // no hard limit, no loop
+    }
+    speed_control_stop();
+    if (ctrl_pool == NULL) {
+        // Own alarm, like the scheduler, so the loop keeps its rate whatever the tasks and sleep_ms() do.
+        ctrl_pool = alarm_pool_create_with_unused_hardware_alarm(1);
+    }
+    return alarm_pool_add_repeating_timer_us(ctrl_pool, -(int64_t)SPEED_CTRL_PERIOD_US, speed_control_tick, NULL,
+                                             &ctrl_timer);
+}
+
+void speed_control_set(bool direction, float target_rpm) {
+    speed_loop_set(&loop, direction, target_rpm);
+}
+
+void speed_control_open_loop(bool direction, uint16_t power) {
+    speed_loop_open_loop(&loop, direction, power);
+}
+
+void speed_control_stop() {
+    speed_loop_stop(&loop);
+}
+
+float speed_control_rpm() {
+    return loop.speed_rpm;
+}
+
+int32_t speed_control_count() {
+    return loop.position;
+}
+
+void speed_control_zero() {
+    speed_loop_zero(&loop);
+}
+
+void speed_control_limit(int32_t limit) {
+    speed_loop_limit(&loop, limit);
+}
+
+void speed_control_clear_limit() {
+    speed_loop_clear_limit(&loop);
+}
+
+bool speed_control_at_limit() {
+    return speed_loop_at_limit(&loop);
+}
+
+stop_predictor_t speed_control_stop_report() {
+    uint32_t irq_state = save_and_disable_interrupts();
+    stop_predictor_t report = loop.stopper;
+    restore_interrupts(irq_state);
+    return report;
+}
+
+speed_control_stats_t speed_control_stats() {
+    return loop.stats;
+}
+
+void speed_control_reset_stats() {
+    uint32_t irq_state = save_and_disable_interrupts();
+    loop.stats = speed_control_stats_t();
+    restore_interrupts(irq_state);
+}
@@ -0,0 +1,136 @@
+/**
+ * @file speed_loop.cpp
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the body of the closed-loop speed controller.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "include/speed_loop.h"
+#include "include/speed_hal.h"
+
+#define SPEED_CTRL_DT           (1.0f / SPEED_CTRL_HZ)
+
+/// Counts per second to output shaft RPM.
+#define SPEED_CPS_TO_RPM        (60.0f / ENCODER_CPR / ENCODER_GEAR)
+
+void speed_loop_init(speed_loop_t* loop, const speed_pid_config_t* cfg, const stop_config_t* stop_cfg) {
+    *loop = speed_loop_t();
+    loop->dir = MOTOR_FW;
+    loop->hard_up = true;
+    speed_pid_init(&loop->pid, cfg);
+    stop_init(&loop->stopper, stop_cfg);
+}
+
+void speed_loop_tick(speed_loop_t* loop, uint32_t now_us, float lag_s) {
+    float cps = speed_hal_velocity(now_us);
+    loop->speed_rpm = cps * SPEED_CPS_TO_RPM;
+    int32_t position = speed_hal_position();
+    loop->position = position;
+
+    // The PIO counts every edge of channel A, including chatter that quadrature decoding rejects. Counting down from
+    // the decoded position on every tick keeps that from adding up over a cut (see STOP_HARD_MARGIN).
+    if (loop->hard_armed && !loop->tripped) {
+        speed_hal_arm_limit(position, loop->hard_limit, loop->hard_up);
+    }
+
+    // Open loop moves (homing, manual retract) run into hard stops on purpose and are not limited.
+    bool cut = (loop->mode != SPEED_OPEN) && stop_update(&loop->stopper, position, cps, SPEED_CTRL_DT, lag_s);
+    loop->at_limit = cut;
+
+    if (loop->restart) {
+        loop->restart = false;
+        speed_pid_reset(&loop->pid, 0.0f);
+    }
+
+    uint16_t pwm = 0;
+    switch (loop->mode) {
+        case SPEED_CLOSED: {
+            if (cut) {
+                speed_pid_reset(&loop->pid, 0.0f);
+                break;
+            }
+            float fwd = (loop->dir == MOTOR_FW) ? loop->speed_rpm : -loop->speed_rpm;
+            pwm = (uint16_t)(speed_pid_update(&loop->pid, loop->target, fwd, SPEED_CTRL_DT) + 0.5f);
+            if (loop->pid.limited) {
+                loop->stats.limited++;
+            }
+            break;
+        }
+        case SPEED_OPEN:
+            pwm = loop->open_pwm;
+            break;
+        default:
+            break;
+    }
+    // The hard limit may have tripped while this tick ran; never write over its cut.
+    uint32_t lock = speed_hal_lock();
+    if (loop->tripped) {
+        pwm = 0;
+        speed_pid_reset(&loop->pid, 0.0f);
+    }
+    speed_hal_motor(loop->dir, pwm);
+    speed_hal_unlock(lock);
+    loop->stats.ticks++;
+}
+
+/**
+ * @brief Changes the command atomically with respect to the tick.
+ *
+ */
+static void command(speed_loop_t* loop, uint8_t m, bool direction, float rpm, uint16_t power) {
+    uint32_t lock = speed_hal_lock();
+    if (m != loop->mode || direction != loop->dir) {
+        loop->restart = true;
+    }
+    loop->mode = m;
+    loop->dir = direction;
+    loop->target = rpm;
+    loop->open_pwm = power;
+    speed_hal_unlock(lock);
+}
+
+void speed_loop_set(speed_loop_t* loop, bool direction, float target_rpm) {
+    command(loop, target_rpm > 0.0f ? SPEED_CLOSED : SPEED_OFF, direction, target_rpm, 0);
+}
+
+void speed_loop_open_loop(speed_loop_t* loop, bool direction, uint16_t power) {
+    speed_loop_clear_limit(loop);
+    command(loop, SPEED_OPEN, direction, 0.0f, power);
+}
+
+void speed_loop_stop(speed_loop_t* loop) {
+    command(loop, SPEED_OFF, loop->dir, 0.0f, 0);
+}
+
+void speed_loop_zero(speed_loop_t* loop) {
+    uint32_t lock = speed_hal_lock();
+    speed_hal_zero();
+    loop->position = 0;
+    speed_hal_unlock(lock);
+}
+
+void speed_loop_limit(speed_loop_t* loop, int32_t limit) {
+    uint32_t lock = speed_hal_lock();
+    stop_arm(&loop->stopper, loop->position, limit);
+    loop->at_limit = false;
+    loop->tripped = false;
+    loop->hard_up = (limit >= loop->position);
+    loop->hard_limit = loop->hard_up ? limit + STOP_HARD_MARGIN : limit - STOP_HARD_MARGIN;
+    loop->hard_armed = true;
+    speed_hal_arm_limit(loop->position, loop->hard_limit, loop->hard_up);
+    speed_hal_unlock(lock);
+}
+
+void speed_loop_clear_limit(speed_loop_t* loop) {
+    uint32_t lock = speed_hal_lock();
+    stop_disarm(&loop->stopper);
+    loop->hard_armed = false;
+    speed_hal_disarm_limit();
+    loop->at_limit = false;
+    loop->tripped = false;
+    speed_hal_unlock(lock);
+}
@@ -0,0 +1,55 @@
+/**
+ * @file speed_pid.cpp
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the motor speed PID.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "include/speed_pid.h"
+
+static float clampf(float v, float lo, float hi) {
+    return v < lo ? lo : (v > hi ? hi : v);
+}
+
+void speed_pid_init(speed_pid_t* pid, const speed_pid_config_t* cfg) {
+    pid->cfg = *cfg;
+    speed_pid_reset(pid, 0.0f);
+}
+
+void speed_pid_reset(speed_pid_t* pid, float out) {
+    pid->integ = 0.0f;
+    pid->d_term = 0.0f;
+    pid->prev_speed = 0.0f;
+    pid->out = out;
+    pid->limited = false;
+}
+
+float speed_pid_update(speed_pid_t* pid, float target, float speed, float dt) {
+    const speed_pid_config_t& c = pid->cfg;
+    if (target <= 0.0f) {
+        speed_pid_reset(pid, 0.0f);
+        return 0.0f;
+    }
+
+    float e = target - speed;
+    float d = -c.kd * (speed - pid->prev_speed) / dt;
+    pid->prev_speed = speed;
+    pid->d_term += c.d_alpha * (d - pid->d_term);
+
+    float want = c.kff * target + c.ff0 + c.kp * e + pid->integ + pid->d_term;
+    float step = c.slew * dt;
+    float out = clampf(want, 0.0f, c.out_max);
+    out = clampf(out, pid->out - step, pid->out + step);
+
+    // Anti-windup: integrate only if that does not push further into the limit that holds the output.
+    pid->limited = (out != want);
+    if (!((out < want && e > 0.0f) || (out > want && e < 0.0f))) {
+        pid->integ = clampf(pid->integ + c.ki * e * dt, -c.out_max, c.out_max);
+    }
+    pid->out = out;
+    return out;
+}
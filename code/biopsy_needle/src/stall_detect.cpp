@@ -0,0 +1,166 @@
+/**
+ * @file stall_detect.cpp
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the motor stall and collision detector.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "include/stall_detect.h"
+
+#define STALL_REF_DIV   64      ///< References move 1/64 of the way per update (~64 ms time constant at CONTROL_HZ).
+
+/**
+ * @brief Starts watching a new motion from the given position.
+ *
+ */
+static void start_motion(stall_detector_t* sd, bool dir, int32_t count, uint32_t now_us) {
+    sd->state = STALL_STARTING;
+    sd->reason = STALL_NONE;
+    sd->dir = dir;
+    sd->start_count = count;
+    sd->last_count = count;
+    sd->moved_us = now_us;
+    sd->ref_rpm = 0.0f;
+    sd->ref_mA = q16_t();
+    sd->slope = q16_t();
+    sd->hist_idx = 0;
+    sd->hist_n = 0;
+    sd->evidence = false;
+}
+
+/**
+ * @brief Adds a current sample and updates the slope over the last STALL_SLOPE_TAPS samples.
+ *
+ */
+static void push_current(stall_detector_t* sd, q16_t current_mA, uint32_t now_us) {
+    sd->hist_mA[sd->hist_idx] = current_mA;
+    sd->hist_us[sd->hist_idx] = now_us;
+    if (++sd->hist_idx == STALL_SLOPE_TAPS) {
+        sd->hist_idx = 0;
+    }
+    if (sd->hist_n < STALL_SLOPE_TAPS) {
+        sd->hist_n++;
+        return;
+    }
+
+    // Full: hist_idx now points at the oldest sample.
+    uint32_t dt = now_us - sd->hist_us[sd->hist_idx];
+    if (dt > 0) {
+        int64_t d = (int64_t)(current_mA - sd->hist_mA[sd->hist_idx]).raw() * 1000 / (int64_t)dt;
+        sd->slope = q16_t::from_raw(fixed_detail::saturate(d));
+    }
+}
+
+/**
+ * @brief A current threshold given for cfg.pwm_full, scaled to the commanded PWM.
+ *
+ */
+static q16_t at_pwm(q16_t threshold, uint16_t pwm, uint16_t pwm_full) {
+    if (pwm >= pwm_full) {
+        return threshold;
+    }
+    return q16_t::from_raw((int32_t)((int64_t)threshold.raw() * pwm / pwm_full));
+}
+
+static void detect(stall_detector_t* sd, stall_reason_t reason, uint32_t evidence_len_us) {
+    sd->state = STALL_DETECTED;
+    sd->reason = reason;
+    sd->evidence_len_us = evidence_len_us;
+    sd->detections++;
+}
+
+void stall_init(stall_detector_t* sd, const stall_config_t* cfg) {
+    *sd = stall_detector_t();
+    sd->cfg = *cfg;
+    stall_reset(sd);
+}
+
+void stall_reset(stall_detector_t* sd) {
+    sd->state = STALL_IDLE;
+    sd->evidence = false;
+}
+
+stall_state_t stall_update(stall_detector_t* sd, bool dir, uint16_t pwm, int32_t count, float rpm, q16_t current_mA,
+                           uint32_t now_us) {
+    const stall_config_t& cfg = sd->cfg;
+
+    if (pwm < cfg.pwm_min) {
+        sd->state = STALL_IDLE;
+        return sd->state;
+    }
+    if (sd->state == STALL_IDLE || dir != sd->dir) {
+        start_motion(sd, dir, count, now_us);
+    }
+
+    push_current(sd, current_mA, now_us);
+    if (count != sd->last_count) {
+        sd->last_count = count;
+        sd->moved_us = now_us;
+    }
+    uint32_t still_us = now_us - sd->moved_us;
+    bool powered = current_mA >= cfg.min_mA;
+
+    switch (sd->state) {
+        case STALL_STARTING: {
+            if (still_us >= cfg.start_us && powered) {
+                detect(sd, STALL_NO_START, still_us);
+            } else if (count - sd->start_count >= cfg.arm_counts || sd->start_count - count >= cfg.arm_counts) {
+                sd->state = STALL_RUNNING;
+                sd->ref_rpm = rpm;
+                sd->ref_mA = current_mA;
+            }
+            break;
+        }
+        case STALL_RUNNING: {
+            if (still_us >= cfg.start_us && powered) {
+                detect(sd, STALL_STOPPED, still_us);
+                break;
+            }
+
+            // The measured speed holds the last count period; no count for still_us caps the real speed.
+            float speed = rpm;
+            if (still_us > 0 && cfg.rpm_count_us / still_us < speed) {
+                speed = cfg.rpm_count_us / still_us;
+            }
+            bool collapse = speed < cfg.vel_frac * sd->ref_rpm;
+            bool step = sd->slope >= at_pwm(cfg.slope_mA_ms, pwm, cfg.pwm_full) ||
+                        current_mA - sd->ref_mA >= at_pwm(cfg.rise_mA, pwm, cfg.pwm_full);
+            if (collapse && step) {
+                if (!sd->evidence) {
+                    sd->evidence = true;
+                    sd->evidence_us = now_us;
+                }
+                if (now_us - sd->evidence_us >= cfg.confirm_us) {
+                    detect(sd, STALL_COLLISION, now_us - sd->evidence_us);
+                }
+                break;
+            }
+
+            // Normal running: follow the speed (rising at once, falling slowly) and the current.
+            sd->evidence = false;
+            if (rpm > sd->ref_rpm) {
+                sd->ref_rpm = rpm;
+            } else {
+                sd->ref_rpm += (rpm - sd->ref_rpm) * (1.0f / STALL_REF_DIV);
+            }
+            sd->ref_mA += (current_mA - sd->ref_mA) / STALL_REF_DIV;
+            break;
+        }
+        default:
+            break;
+    }
+    return sd->state;
+}
+
+const char* stall_reason_name(stall_reason_t reason) {
+    switch (reason) {
+        case STALL_NO_START:    return "no start";
+        case STALL_STOPPED:     return "stopped";
+        case STALL_COLLISION:   return "collision";
+        default:                return "none";
+    }
+}
@@ -0,0 +1,75 @@
+/**
+ * @file stop_predict.cpp
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the predictive end-of-travel stop.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "include/stop_predict.h"
+
+void stop_init(stop_predictor_t* sp, const stop_config_t* cfg) {
+    *sp = stop_predictor_t();
+    sp->cfg = *cfg;
+    sp->tau = cfg->tau;
+}
+
+void stop_arm(stop_predictor_t* sp, int32_t position, int32_t limit) {
+    sp->armed = true;
+    sp->forward = (limit >= position);
+    sp->limit = limit;
+    sp->cut = false;
+    sp->settled = false;
+}
+
+void stop_disarm(stop_predictor_t* sp) {
+    sp->armed = false;
+}
+
+/**
+ * @brief Learns the coast time from a finished stop.
+ *
+ */
+static void learn(stop_predictor_t* sp, float lag) {
+    float v = sp->cut_cps;
+    float coast = (float)(sp->forward ? sp->rest_at - sp->cut_at : sp->cut_at - sp->rest_at) - v * lag;
+    // Stops from a crawl coast less than a count; they say nothing about the braking.
+    if (v <= 0.0f || coast < 2.0f) {
+        return;
+    }
+    float measured = coast / v;
+    float t = sp->tau + sp->cfg.learn * (measured - sp->tau);
+    sp->tau = t < sp->cfg.tau_min ? sp->cfg.tau_min : (t > sp->cfg.tau_max ? sp->cfg.tau_max : t);
+}
+
+bool stop_update(stop_predictor_t* sp, int32_t position, float cps, float period, float lag) {
+    if (!sp->armed) {
+        return false;
+    }
+    if (sp->cut) {
+        if (!sp->settled && cps == 0.0f) {
+            sp->settled = true;
+            sp->rest_at = position;
+            sp->stops++;
+            learn(sp, lag);
+        }
+        return true;
+    }
+
+    float v = sp->forward ? cps : -cps;
+    float remaining = (float)(sp->forward ? sp->limit - position : position - sp->limit);
+    float coast = (v > 0.0f) ? v * (lag + sp->tau) : 0.0f;
+    float land = remaining - coast;
+    // Cutting one tick later lands v * period further; cut now if that is closer to the limit.
+    if (remaining <= 0.0f || land < 0.5f * v * period) {
+        sp->cut = true;
+        sp->cut_at = position;
+        sp->cut_cps = v > 0.0f ? v : 0.0f;
+        sp->predicted = sp->forward ? (float)sp->limit - land : (float)sp->limit + land;
+        return true;
+    }
+    return false;
+}
@@ -0,0 +1,330 @@
+/**
+ * @file dsp_test.cpp
+ * @author Thomas Chang
+ * @brief Host test and benchmark of the header-only filters in dsp_filters.h.
+ * @details Usage:
+ *
+ *     dsp_test [--samples N]
+ *
+ * Checks, on simulated motor current, load cell and RPM signals:
+ *
+ *  - MovingAverage and OnePole with the MAF_SZ and LP_ALPHA of control_core.h against the hand-written MAF ring and
+ *    low pass that main.cpp had before, in float and in q16_t as the firmware runs them.
+ *  - RunningMedian against a sort of the same window, for several window sizes and with repeated values.
+ *  - q16_t OnePole and Biquad (low pass and notch) against the same filters in float.
+ *  - Kalman1D: the gain converges to the steady state of the Riccati equation, after which the filter is the OnePole
+ *    with that gain, and the estimate of a constant converges to its value.
+ *  - FilterChain gives the same output as running its stages by hand.
+ *
+ * Then every filter is timed per update() in float and in q16_t. Host times only rank the types; on the M0+ every float
+ * operation is a library call, which is what the q16_t pipelines avoid. Exits with 1 if a check fails.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "control_core.h"
+#include "dsp_filters.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static int failures = 0;
+
+/**
+ * @brief Records a failure when the largest error of a check is above its bound. Prints the error either way.
+ *
+ */
+static void checkError(const char* what, double err, double bound) {
+    bool ok = err <= bound;
+    printf("%-4s  %-58s max error %.3g (bound %.3g)\n", ok ? "ok" : "FAIL", what, err, bound);
+    failures += !ok;
+}
+
+static void check(bool ok, const char* what) {
+    printf("%-4s  %s\n", ok ? "ok" : "FAIL", what);
+    failures += !ok;
+}
+
+static q16_t toQ16(float v) {
+    return q16_t::from_raw((int32_t)lroundf(v * 65536.0f));
+}
+
+/**
+ * @brief Motor current in mA as the INA219 reports it: a load that ramps and steps, with noise and spikes.
+ *
+ */
+static vector<float> currentSignal(size_t n, uint32_t seed) {
+    mt19937 rng(seed);
+    normal_distribution<float> noise(0.0f, 15.0f);
+    vector<float> x(n);
+    for (size_t i = 0; i < n; i++) {
+        float load = 250.0f + 0.02f * (float)(i % 20000) + ((i / 3000) % 2 ? 120.0f : 0.0f);
+        x[i] = roundf((load + noise(rng) + (rng() % 500 == 0 ? 900.0f : 0.0f)) * 10.0f) / 10.0f;   // 0.1 mA LSB
+    }
+    return x;
+}
+
+// ==== Against the previous main.cpp code ==== //
+
+/**
+ * @brief The MAF ring and low pass that main.cpp updated inline before dsp_filters.h.
+ *
+ */
+struct OldCurrentFilters {
+    float MAF[MAF_SZ] = {0};
+    int MAF_counter = 0;
+    float MAF_sum = 0;
+    float lp_current = 0;
+
+    void update(float current_mA, float* maf, float* lp) {
+        if (MAF_counter == MAF_SZ) {
+            MAF_counter = 0;
+        }
+        MAF_sum -= MAF[MAF_counter];
+        MAF_sum += current_mA;
+        MAF[MAF_counter] = current_mA;
+        MAF_counter++;
+        *maf = MAF_sum * 1.0f / MAF_SZ;
+        *lp = LP_ALPHA * current_mA + (1 - LP_ALPHA) * lp_current;
+        lp_current = *lp;
+    }
+};
+
+static void testAgainstOld(size_t n) {
+    vector<float> x = currentSignal(n, 1);
+    OldCurrentFilters old;
+    MovingAverage<float, MAF_SZ> mafF;
+    OnePole<float> lpF(LP_ALPHA);
+    MovingAverage<q16_t, MAF_SZ> mafQ;
+    OnePole<q16_t> lpQ(LP_ALPHA);
+
+    double mafFErr = 0, lpFErr = 0, mafQErr = 0, lpQErr = 0, oldExactErr = 0, mafQExactErr = 0;
+    for (size_t i = 0; i < n; i++) {
+        float maf, lp;
+        old.update(x[i], &maf, &lp);
+        double exact = 0;
+        for (size_t k = 0; k < MAF_SZ; k++) {
+            exact += (i >= k) ? x[i - k] : 0.0;
+        }
+        exact /= MAF_SZ;
+
+        double q = mafQ.update(toQ16(x[i])).raw() / 65536.0;
+        mafFErr = max(mafFErr, (double)fabsf(mafF.update(x[i]) - maf));
+        lpFErr = max(lpFErr, (double)fabsf(lpF.update(x[i]) - lp));
+        mafQErr = max(mafQErr, fabs(q - maf));
+        lpQErr = max(lpQErr, (double)fabsf(lpQ.update(toQ16(x[i])).to_float() - lp));
+        oldExactErr = max(oldExactErr, fabs(maf - exact));
+        mafQExactErr = max(mafQExactErr, fabs(q - exact));
+    }
+    // Both float running sums drift from the true window sum by their own roundings, so they differ from each other by
+    // a small fraction of the 0.1 mA the current is resolved to. The q16_t sum is exact: its only errors are the
+    // rounding of the input and the truncation of the mean, 1.5 LSB.
+    checkError("MovingAverage<float> vs old MAF ring (mA)", mafFErr, 0.02);
+    checkError("OnePole<float> vs old low pass (mA)", lpFErr, 1e-3);
+    checkError("MovingAverage<q16_t> vs old MAF ring (mA)", mafQErr, 0.02);
+    checkError("OnePole<q16_t> vs old low pass (mA)", lpQErr, 2e-3);
+    checkError("MovingAverage<q16_t> vs exact window mean (mA)", mafQExactErr, 1.5 / 65536);
+    printf("      old MAF ring vs exact window mean: %.3g mA\n", oldExactErr);
+}
+
+// ==== Running median ==== //
+
+template <typename T, size_t N>
+static bool medianMatchesSort(const vector<T>& x) {
+    RunningMedian<T, N> med;
+    vector<T> window(N, T(0));
+    for (size_t i = 0; i < x.size(); i++) {
+        window[i % N] = x[i];
+        vector<T> sorted = window;
+        sort(sorted.begin(), sorted.end());
+        if (med.update(x[i]) != sorted[N / 2]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void testMedian(size_t n) {
+    mt19937 rng(3);
+    vector<float> wide(n), narrow(n);
+    vector<int32_t> ints(n);
+    vector<q16_t> fixed(n);
+    for (size_t i = 0; i < n; i++) {
+        wide[i] = (float)(rng() % 100000) / 7.0f - 5000.0f;
+        narrow[i] = (float)(rng() % 4);                     // many repeated values in one window
+        ints[i] = (int32_t)(rng() % 9) - 4;
+        fixed[i] = q16_t::from_raw((int32_t)rng());
+    }
+    check(medianMatchesSort<float, 3>(wide) && medianMatchesSort<float, 5>(wide) &&
+              medianMatchesSort<float, 15>(wide),
+          "RunningMedian<float, 3/5/15> matches a sort of the window");
+    check(medianMatchesSort<float, 3>(narrow) && medianMatchesSort<float, 7>(narrow) &&
+              medianMatchesSort<int32_t, 5>(ints) && medianMatchesSort<int32_t, 9>(ints),
+          "RunningMedian matches a sort with repeated values");
+    check(medianMatchesSort<q16_t, FORCE_MED>(fixed) && medianMatchesSort<q16_t, 11>(fixed),
+          "RunningMedian<q16_t, FORCE_MED/11> matches a sort of the window");
+}
+
+// ==== Fixed against float ==== //
+
+template <typename FF, typename FQ>
+static double trackError(FF& f, FQ& q, const vector<float>& x) {
+    double err = 0;
+    for (float v : x) {
+        err = max(err, (double)fabsf(q.update(toQ16(v)).to_float() - f.update(v)));
+    }
+    return err;
+}
+
+static void testFixedVsFloat(size_t n) {
+    vector<float> x = currentSignal(n, 4);
+
+    OnePole<float> lpF(FORCE_ALPHA);
+    OnePole<q16_t> lpQ(FORCE_ALPHA);
+    checkError("OnePole<q16_t> vs float, alpha FORCE_ALPHA (mA)", trackError(lpF, lpQ, x), 1e-3);
+
+    OnePole<float> slowF(0.01f);
+    OnePole<q16_t> slowQ(0.01f);
+    checkError("OnePole<q16_t> vs float, alpha 0.01 (mA)", trackError(slowF, slowQ, x), 1e-3);
+
+    BiquadCoeffs lp = BiquadCoeffs::lowpass(CURRENT_HZ, CURRENT_HZ / 25.0f);
+    Biquad<float> bqF(lp);
+    Biquad<q16_t> bqQ(lp);
+    checkError("Biquad<q16_t> low pass vs float (mA)", trackError(bqF, bqQ, x), 2e-3);
+
+    BiquadCoeffs notch = BiquadCoeffs::notch(CURRENT_HZ, CURRENT_HZ / 10.0f, 5.0f);
+    Biquad<float> nF(notch);
+    Biquad<q16_t> nQ(notch);
+    checkError("Biquad<q16_t> notch vs float (mA)", trackError(nF, nQ, x), 2e-3);
+}
+
+// ==== Kalman ==== //
+
+static void testKalman(size_t n) {
+    // Steady state of p' = p + q, k = p' / (p' + r), p = (1 - k) p': p'^2 - q p' - q r = 0.
+    double pPrior = (RPM_Q + sqrt((double)RPM_Q * RPM_Q + 4.0 * RPM_Q * RPM_R)) / 2.0;
+    double kInf = pPrior / (pPrior + RPM_R);
+
+    Kalman1D<float> kf(RPM_Q, RPM_R);
+    mt19937 rng(5);
+    normal_distribution<float> noise(0.0f, sqrtf(RPM_R));
+    for (int i = 0; i < 200; i++) {
+        kf.update(700.0f + noise(rng));
+    }
+    checkError("Kalman1D gain vs Riccati steady state", fabs(kf.gain() - kInf), 1e-6);
+
+    // Converged, it is a OnePole with alpha = gain.
+    OnePole<float> lp(kf.gain());
+    lp.reset(kf.value());
+    double err = 0;
+    for (size_t i = 0; i < n; i++) {
+        float z = 700.0f + noise(rng);
+        err = max(err, (double)fabsf(kf.update(z) - lp.update(z)));
+    }
+    checkError("Kalman1D converged vs OnePole(gain) (RPM)", err, 1e-2);
+
+    // A constant seen through noise, with no process noise, is estimated ever better.
+    Kalman1D<float> still(0.0f, RPM_R, 1e6f);
+    for (int i = 0; i < 20000; i++) {
+        still.update(712.0f + noise(rng));
+    }
+    checkError("Kalman1D q = 0 estimate of a constant (RPM)", fabsf(still.value() - 712.0f), 1.0);
+}
+
+// ==== FilterChain ==== //
+
+static void testChain(size_t n) {
+    vector<float> x = currentSignal(n, 6);
+    FilterChain<q16_t, RunningMedian<q16_t, FORCE_MED>, OnePole<q16_t>> chain{RunningMedian<q16_t, FORCE_MED>(),
+                                                                               OnePole<q16_t>(FORCE_ALPHA)};
+    RunningMedian<q16_t, FORCE_MED> med;
+    OnePole<q16_t> lp(FORCE_ALPHA);
+    bool same = true;
+    for (float v : x) {
+        q16_t y = chain.update(toQ16(v));
+        same &= (y == lp.update(med.update(toQ16(v)))) && (chain.value() == y);
+    }
+    chain.reset(toQ16(5.0f));
+    same &= chain.value() == toQ16(5.0f) && chain.stage<1>().value() == toQ16(5.0f);
+    check(same, "FilterChain<median, one-pole> equals its stages run by hand, reset reaches every stage");
+}
+
+// ==== Benchmark ==== //
+
+template <typename T, typename Filter>
+static double nsPerUpdate(Filter& f, const vector<T>& x, int passes) {
+    T sink = T(0);
+    auto t0 = chrono::steady_clock::now();
+    for (int p = 0; p < passes; p++) {
+        for (const T& v : x) {
+            sink = f.update(v);
+        }
+    }
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count();
+    volatile float keep = (float)(sink != T(0));
+    (void)keep;
+    return ns / ((double)passes * x.size());
+}
+
+static void bench() {
+    vector<float> xf = currentSignal(4096, 7);
+    vector<q16_t> xq(xf.size());
+    for (size_t i = 0; i < xf.size(); i++) {
+        xq[i] = toQ16(xf[i]);
+    }
+    const int passes = 200;
+    BiquadCoeffs lp = BiquadCoeffs::lowpass(CURRENT_HZ, CURRENT_HZ / 25.0f);
+
+    MovingAverage<float, MAF_SZ> mafF;
+    MovingAverage<q16_t, MAF_SZ> mafQ;
+    OnePole<float> opF(LP_ALPHA);
+    OnePole<q16_t> opQ(LP_ALPHA);
+    Biquad<float> bqF(lp);
+    Biquad<q16_t> bqQ(lp);
+    RunningMedian<float, FORCE_MED> medF;
+    RunningMedian<q16_t, FORCE_MED> medQ;
+    Kalman1D<float> kf(RPM_Q, RPM_R);
+
+    printf("\nhost ns per update()          float    q16_t\n");
+    printf("  MovingAverage<%d>        %7.2f  %7.2f\n", MAF_SZ, nsPerUpdate(mafF, xf, passes),
+           nsPerUpdate(mafQ, xq, passes));
+    printf("  OnePole                  %7.2f  %7.2f\n", nsPerUpdate(opF, xf, passes), nsPerUpdate(opQ, xq, passes));
+    printf("  Biquad                   %7.2f  %7.2f\n", nsPerUpdate(bqF, xf, passes), nsPerUpdate(bqQ, xq, passes));
+    printf("  RunningMedian<%d>        %7.2f  %7.2f\n", FORCE_MED, nsPerUpdate(medF, xf, passes),
+           nsPerUpdate(medQ, xq, passes));
+    printf("  Kalman1D                 %7.2f        -\n", nsPerUpdate(kf, xf, passes));
+}
+
+int main(int argc, char** argv) {
+    size_t samples = 200000;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--samples" && i + 1 < argc) {
+            samples = strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: dsp_test [--samples N]\n");
+            return 2;
+        }
+    }
+
+    testAgainstOld(samples);
+    testMedian(samples / 10);
+    testFixedVsFloat(samples);
+    testKalman(samples);
+    testChain(samples);
+    bench();
+
+    printf("%s\n", failures ? "FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
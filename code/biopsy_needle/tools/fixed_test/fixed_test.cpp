@@ -0,0 +1,161 @@
+/**
+ * @file fixed_test.cpp
+ * @author Thomas Chang
+ * @brief Host test of the Q16.16 sensor conversions (fixed_point.h) against exact values and the old float paths.
+ * @details Usage:
+ *
+ *     fixed_test
+ *
+ * Every input the firmware can see is converted, and the result is compared with an exact double reference:
+ *  - every INA219 current register code to mA,
+ *  - every FX29 bridge code to N,
+ *  - encoder counts from -2M to +2M to output revolutions,
+ *  - every possible ADC average (a sum of ADC_AVG_SAMPLES 12-bit conversions) to battery % and speed %.
+ *
+ * The conversions are the ones of sensor_units.h, which the firmware uses. The largest error of the fixed-point path
+ * must stay within MAX_FIXED_ERR, just under one Q16 LSB (1.53e-5). The float code that main.cpp had before is run on
+ * the same inputs and its largest error is printed for comparison.
+ * Battery % and speed % are whole numbers; a result may only differ from the exact floor where the exact value lies
+ * less than STEP_SLACK below the next integer, and at most MAX_STEP_MISSES times. Exits with 1 if a check fails.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "sensor_units.h"
+#include "adc_sampler.h"
+
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+
+using namespace std;
+
+static const double MAX_FIXED_ERR = 1.2e-5;     ///< Largest allowed |fixed - exact|, in output units.
+static const double STEP_SLACK = 1e-5;          ///< How close below an integer step a % may round up.
+static const int MAX_STEP_MISSES = 4;           ///< % results allowed to differ from the exact floor.
+static const int32_t ENCODER_SPAN = 2000000;
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        printf("FAIL  %s\n", what);
+        failures++;
+    }
+}
+
+static double value(q16_t q) {
+    return q.raw() / 65536.0;       // exact, unlike to_float()
+}
+
+/**
+ * @brief Largest error of the fixed and the float path over a range of inputs.
+ *
+ */
+struct Errors {
+    double fixed = 0.0;
+    double flt = 0.0;
+    int32_t worstInput = 0;
+
+    void add(int32_t in, double exact, q16_t fixedOut, float floatOut) {
+        double e = fabs(value(fixedOut) - exact);
+        if (e > fixed) {
+            fixed = e;
+            worstInput = in;
+        }
+        flt = fmax(flt, fabs((double)floatOut - exact));
+    }
+
+    void report(const char* what) {
+        printf("  %-26s fixed %.3g (at %ld)   old float %.3g\n", what, fixed, (long)worstInput, flt);
+        char label[96];
+        snprintf(label, sizeof(label), "%s: fixed-point error within %.3g", what, MAX_FIXED_ERR);
+        check(fixed <= MAX_FIXED_ERR, label);
+    }
+};
+
+static void testIna219() {
+    Errors err;
+    const float lsb = (float)(INA219_MAX_AMPS / 32768.0);      // INA219::_current_LSB was a float
+    for (int32_t code = INT16_MIN; code <= INT16_MAX; code++) {
+        double exact = code * (INA219_MAX_AMPS / 32768.0) * 1000.0;
+        float old = (float)(int16_t)code * lsb * 1000;
+        err.add(code, exact, inaToMilliamps((int16_t)code), old);
+    }
+    err.report("INA219 current (mA)");
+}
+
+static void testFx29() {
+    Errors err;
+    for (int32_t code = 0; code <= 0x3FFF; code++) {
+        double exact = (code - FX29_ZERO_COUNTS) * FX29_N_PER_COUNT;
+        float old = (code - 1000.0f) * 0.00794f;
+        err.add(code, exact, fx29ToNewtons(code), old);
+    }
+    err.report("FX29 force (N)");
+}
+
+static void testEncoder() {
+    Errors err;
+    const double countsPerRev = ENCODER_CPR * (double)ENCODER_GEAR;
+    for (int32_t count = -ENCODER_SPAN; count <= ENCODER_SPAN; count++) {
+        float old = count / (double)ENCODER_CPR / ENCODER_GEAR;
+        err.add(count, count / countsPerRev, countsToRev(count), old);
+    }
+    err.report("encoder (revolutions)");
+}
+
+/**
+ * @brief Battery % and speed % for every ADC average adc_sampler.cpp can publish.
+ * @details The sampler publishes (sum << 16) / ADC_AVG_SAMPLES, so each sum of ADC_AVG_SAMPLES conversions is one
+ * input. The old code used a truncated integer average; here the exact reference is the floor of the exact value.
+ */
+static void testAdcMaps() {
+    Errors batErr, spdErr;
+    int batMisses = 0, spdMisses = 0;
+    bool missesNearStep = true;
+    const uint32_t maxSum = 4095u * ADC_AVG_SAMPLES;
+
+    for (uint32_t sum = 0; sum <= maxSum; sum++) {
+        q16_t avg = q16_t::from_raw((int32_t)(((uint64_t)sum << 16) / ADC_AVG_SAMPLES));
+        double adc = value(avg);
+
+        // getBatLevel()
+        q16_t batQ = batteryPercent(avg);
+        double batExact = (fmin(fmax(adc, BAT_MIN_ADC), BAT_MAX_ADC) - BAT_MIN_ADC) * BAT_ADC_PER;
+        batErr.add((int32_t)sum, batExact, batQ, (float)batExact);
+        if (batQ.to_int() != (int32_t)floor(batExact)) {
+            batMisses++;
+            missesNearStep &= ceil(batExact) - batExact < STEP_SLACK;
+        }
+
+        // getInputSpeed()
+        q16_t spdQ = potToSpeed(avg);
+        double spdExact = POT_SPEED_PER_ADC * adc + 1;
+        spdErr.add((int32_t)sum, spdExact, spdQ, (float)(0.0243 * (float)adc + 1));
+        if (spdQ.to_int() != (int32_t)floor(spdExact)) {
+            spdMisses++;
+            missesNearStep &= ceil(spdExact) - spdExact < STEP_SLACK;
+        }
+    }
+
+    batErr.report("battery (%)");
+    spdErr.report("speed (%)");
+    printf("  whole %% off the exact floor: battery %d, speed %d of %u inputs\n", batMisses, spdMisses, maxSum + 1);
+    check(batMisses + spdMisses <= MAX_STEP_MISSES, "few whole % results off the exact floor");
+    check(missesNearStep, "whole % results off the exact floor lie just below a step");
+}
+
+int main() {
+    printf("largest error against the exact value\n");
+    testIna219();
+    testFx29();
+    testEncoder();
+    testAdcMaps();
+
+    printf("%s\n", failures ? "FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,271 @@
+/**
+ * @file format_test.cpp
+ * @author Thomas Chang
+ * @brief Host test and benchmark of the allocation-free formatter (ntm_format.h) against printf.
+ * @details Usage:
+ *
+ *     format_test [--floats N]
+ *
+ * fmt_uint() and fmt_int() are compared with "%*u", "%*d" and "%0*d" for edge values and random values and widths.
+ * fmt_fixed() is compared with "%.*f" and "%*.*f" for every float exponent, for --floats random bit patterns at
+ * random decimals, and for values next to decimal rounding boundaries. Two documented differences are allowed for:
+ * an exact binary tie is rounded away from zero (printf rounds it to even), and a result that rounds to zero has no
+ * sign. A cut-short buffer must hold a prefix of the full text.
+ *
+ * The benchmark times fmt_fixed() against snprintf() and against std::to_string(), which the display used before, on
+ * the values the OLED shows. Host times only rank the paths; on the M0+ both printf paths also run soft-float double
+ * code. Exits with 1 if a check fails.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "ntm_format.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+
+using namespace std;
+
+static int failures = 0;
+static const int MAX_REPORTS = 10;
+
+static void fail(const char* what, const char* got, const char* want) {
+    if (failures++ < MAX_REPORTS) {
+        printf("FAIL  %s: got \"%s\", want \"%s\"\n", what, got, want);
+    }
+}
+
+// ==== Integers ==== //
+
+static void testIntegers() {
+    static const int64_t edges[] = {0, 1, -1, 9, 10, -10, 99, 100, 65535, -65536, INT32_MAX, INT32_MIN, UINT32_MAX};
+    mt19937 rng(1);
+    char got[48], want[48];
+    fmt_t f;
+
+    for (int i = 0; i < 200000; i++) {
+        int64_t v = (i < (int)(sizeof(edges) / sizeof(edges[0]))) ? edges[i] : (int64_t)(int32_t)rng();
+        uint8_t width = (uint8_t)(rng() % 14);
+
+        if (v >= 0) {
+            fmt_init(&f, got, sizeof(got));
+            fmt_uint(&f, (uint32_t)v, width);
+            snprintf(want, sizeof(want), "%*u", width, (unsigned)v);
+            if (strcmp(got, want)) {
+                fail("fmt_uint", got, want);
+            }
+            fmt_init(&f, got, sizeof(got));
+            fmt_uint(&f, (uint32_t)v, width, '0');
+            snprintf(want, sizeof(want), "%0*u", width, (unsigned)v);
+            if (strcmp(got, want)) {
+                fail("fmt_uint zero padded", got, want);
+            }
+        }
+        if (v >= INT32_MIN && v <= INT32_MAX) {
+            fmt_init(&f, got, sizeof(got));
+            fmt_int(&f, (int32_t)v, width);
+            snprintf(want, sizeof(want), "%*d", width, (int)v);
+            if (strcmp(got, want)) {
+                fail("fmt_int", got, want);
+            }
+            fmt_init(&f, got, sizeof(got));
+            fmt_int(&f, (int32_t)v, width, '0');
+            snprintf(want, sizeof(want), "%0*d", width, (int)v);
+            if (strcmp(got, want)) {
+                fail("fmt_int zero padded", got, want);
+            }
+        }
+    }
+}
+
+// ==== Fixed point ==== //
+
+/**
+ * @brief True if v * 10^decimals lies exactly halfway between two integers.
+ * @details With v = m * 2^e that is v * 10^d * 2 = m * 5^d * 2^(d+e+1) being an integer while v * 10^d is not, which
+ * comes down to the trailing zeros of m.
+ */
+static bool exactTie(float v, int decimals) {
+    uint32_t bits;
+    memcpy(&bits, &v, sizeof(bits));
+    uint32_t m = bits & 0x7FFFFF;
+    int32_t e = (int32_t)((bits >> 23) & 0xFF);
+    if (e == 0) {
+        e = -149;
+    } else {
+        m |= 0x800000;
+        e -= 150;
+    }
+    if (m == 0) {
+        return false;
+    }
+    return __builtin_ctz(m) + decimals + e == -1;
+}
+
+/**
+ * @brief What fmt_fixed() should print, from printf on the exact value.
+ *
+ */
+static void reference(char* out, size_t cap, float v, int decimals, int width) {
+    if (v != v) {
+        snprintf(out, cap, "%*s", width, "nan");
+        return;
+    }
+    if (fabsf(v) >= 4294967296.0f) {
+        snprintf(out, cap, "%*s", width, "ovf");
+        return;
+    }
+    double d = v;
+    if (exactTie(v, decimals)) {
+        // Nudge past the tie by far less than the last printed digit, so printf rounds it away from zero.
+        d = nextafter(d, d < 0 ? -INFINITY : INFINITY);
+    }
+    char digits[64];
+    snprintf(digits, sizeof(digits), "%.*f", decimals, d);
+    const char* s = digits;
+    if (s[0] == '-' && strspn(s + 1, "0.") == strlen(s + 1)) {
+        s++;
+    }
+    snprintf(out, cap, "%*s", width, s);
+}
+
+static void checkFixed(float v, int decimals, int width, const char* what) {
+    char got[64], want[64];     // room for all the digits reference() can print
+    fmt_t f;
+    fmt_init(&f, got, sizeof(got));
+    fmt_fixed(&f, v, (uint8_t)decimals, (uint8_t)width);
+    reference(want, sizeof(want), v, decimals, width);
+    if (strcmp(got, want)) {
+        char label[96];
+        snprintf(label, sizeof(label), "%s, fmt_fixed(%.9g, %d, %d)", what, v, decimals, width);
+        fail(label, got, want);
+    }
+}
+
+static void testFixed(uint32_t floats) {
+    mt19937 rng(2);
+
+    // Every exponent, including the subnormals and the values too small for any shift to reach.
+    for (uint32_t exp = 0; exp < 256; exp++) {
+        for (int k = 0; k < 64; k++) {
+            uint32_t bits = (exp << 23) | (rng() & 0x7FFFFF) | ((k & 1) << 31);
+            float v;
+            memcpy(&v, &bits, sizeof(v));
+            checkFixed(v, k % 10, 0, "exponent sweep");
+        }
+    }
+
+    // Random bit patterns at random decimals and widths.
+    for (uint32_t i = 0; i < floats; i++) {
+        uint32_t bits = rng();
+        float v;
+        memcpy(&v, &bits, sizeof(v));
+        checkFixed(v, rng() % 10, (rng() % 4 == 0) ? rng() % 16 : 0, "random");
+    }
+
+    // Either side of decimal rounding boundaries, where a carry ripples into the integer part.
+    for (int decimals = 0; decimals <= FMT_MAX_DECIMALS; decimals++) {
+        for (int i = 0; i < 20000; i++) {
+            double boundary = (double)(rng() % 100000) / pow(10.0, rng() % 6) + 0.5 / pow(10.0, decimals);
+            float v = (float)boundary;
+            checkFixed(v, decimals, 0, "rounding boundary");
+            checkFixed(nextafterf(v, 0.0f), decimals, 0, "rounding boundary");
+            checkFixed(nextafterf(v, INFINITY), decimals, 0, "rounding boundary");
+            checkFixed(-v, decimals, 0, "rounding boundary");
+        }
+    }
+
+    // Values from the review and the documented special cases.
+    static const float specials[] = {1.06e-24f, 1e-45f, 1.17549435e-38f, 0.0f, -0.0f, 0.5f, 1.5f, 2.5f, -2.5f, 0.125f,
+                                     0.0049f, -0.004f, 999.9999f, 4294967040.0f, 4294967296.0f, -5e9f};
+    for (float v : specials) {
+        for (int decimals = 0; decimals <= FMT_MAX_DECIMALS; decimals++) {
+            checkFixed(v, decimals, 0, "special");
+        }
+    }
+    checkFixed(NAN, 2, 6, "special");
+
+    // A short buffer keeps a terminated prefix.
+    char full[48], cut[6];
+    fmt_t f;
+    fmt_init(&f, full, sizeof(full));
+    fmt_fixed(&f, -12345.678f, 3);
+    fmt_init(&f, cut, sizeof(cut));
+    fmt_fixed(&f, -12345.678f, 3);
+    if (strncmp(cut, full, sizeof(cut) - 1) || strlen(cut) != sizeof(cut) - 1) {
+        fail("short buffer", cut, full);
+    }
+}
+
+// ==== Benchmark ==== //
+
+template <typename F>
+static double nsPer(int reps, F fn) {
+    auto t0 = chrono::steady_clock::now();
+    for (int i = 0; i < reps; i++) {
+        fn(i);
+    }
+    return chrono::duration<double, nano>(chrono::steady_clock::now() - t0).count() / reps;
+}
+
+static void bench() {
+    static float values[1024];
+    for (int i = 0; i < 1024; i++) {
+        values[i] = 300.0f + 0.37f * i;     // CUR, SPD, POS and FRC readings are of this size
+    }
+    volatile size_t sink = 0;
+    const int reps = 1000000;
+
+    double fmtNs = nsPer(reps, [&](int i) {
+        char text[32];
+        fmt_t f;
+        fmt_init(&f, text, sizeof(text));
+        fmt_fixed(&f, values[i & 1023], 2);
+        sink = sink + f.len;
+    });
+    double printfNs = nsPer(reps, [&](int i) {
+        char text[32];
+        sink = sink + snprintf(text, sizeof(text), "%.2f", values[i & 1023]);
+    });
+    double stringNs = nsPer(reps, [&](int i) {
+        string text = to_string(values[i & 1023]);
+        sink = sink + text.size();
+    });
+
+    printf("one display reading, 2 decimals (host ns per call)\n");
+    printf("  fmt_fixed          %6.1f\n", fmtNs);
+    printf("  snprintf           %6.1f   %.1fx\n", printfNs, printfNs / fmtNs);
+    printf("  std::to_string     %6.1f   %.1fx, with a heap allocation\n", stringNs, stringNs / fmtNs);
+}
+
+int main(int argc, char** argv) {
+    uint32_t floats = 3000000;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--floats" && i + 1 < argc) {
+            floats = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: format_test [--floats N]\n");
+            return 2;
+        }
+    }
+
+    testIntegers();
+    testFixed(floats);
+    bench();
+
+    if (failures > MAX_REPORTS) {
+        printf("... %d failures in total\n", failures);
+    }
+    printf("%s\n", failures ? "FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,614 @@
+/**
+ * @file host_sim.cpp
+ * @author Thomas Chang
+ * @brief Host build of the control core (control_core.cpp) against simulated motor, encoder and sensors.
+ * @details Usage:
+ *
+ *     host_sim [--model model.csv] [--tissue tissue.csv] [--volts V] [--load SCALE] [--cuts N] [--trace out.csv]
+ *              [--chatter RATE] [--quiet]
+ *
+ * The firmware's control core, speed loop (tick, commands, travel limits), speed PID, stop predictor, motion profile,
+ * stall detector and M/T velocity estimate run unchanged; this file stands in for main.cpp and for the SDK side of
+ * speed_control.cpp and quad_encoder.c. It implements control_hal.h and speed_hal.h and runs the rate groups on
+ * simulated time: speed_loop_tick() and control_tick() at 1 kHz, control_current() at CURRENT_HZ, control_force() at
+ * FORCE_HZ and control_inputs() at DISPLAY_HZ. Behind them sit
+ *
+ *  - the drive and tissue model of tools/needle_model, with hard stops (the housing, an obstacle),
+ *  - the encoder state machines: the quadrature count, the edge periods of channel A in PIO clock counts through the
+ *    8 deep FIFO the estimator drains, and the limit_watch countdown that cuts the PWM on the edge it reaches,
+ *  - the INA219 current register (LSB quantisation, noise, clipping, an occasional late read),
+ *  - the FX29 bridge data (14 bit, noise, a spike now and then for the median),
+ *  - the speed potentiometer and battery ADC, through the same conversions as main.cpp.
+ *
+ * For 30, 60 and 100 % on the potentiometer it presses the button through a whole procedure: a cut to fwRev and back,
+ * a cut into an obstacle that has to be caught by the stall detector, and homing (ZERO) into the housing. Every step is
+ * checked (landing error, cutting speed, log records, stall, homing) and the tool exits with 1 if any check fails, so
+ * it can run as a regression test after a change to the control code. At the end it prints how much faster than real
+ * time the simulation ran and the host time per call of the control core, as a relative benchmark of the hot path.
+ *
+ * --model and --tissue load the parameters and tissue table model_fit wrote from recorded runs; --volts overrides the
+ * battery voltage and --load scales the tissue force. --cuts N skips the procedure and runs N cuts at full speed, each
+ * into tissue of a random hardness (0.5 to 2 times the table), for tuning: it prints the landing errors, which fail
+ * the run past 50 um like in the procedure, and how many cuts per minute the host simulates. --trace writes every log
+ * record in the CSV layout of the firmware, which model_fit reads like a recorded run. --chatter adds RATE dither
+ * cycles (1 us glitches) per ms on channel A, at random times, which quadrature decoding rejects but the edge period
+ * FIFO and the PIO hard limit see.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "control_core.h"
+#include "control_hal.h"
+#include "sensor_units.h"
+#include "speed_loop.h"
+#include "speed_hal.h"
+#include "quad_velocity.h"
+#include "needle_model.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const double COUNTS_PER_REV = ENCODER_CPR * (double)ENCODER_GEAR;
+static const double UM_PER_COUNT = 500.0 / COUNTS_PER_REV;     ///< 0.5 mm of travel per output revolution.
+static const double CPS_PER_RPM = COUNTS_PER_REV / 60.0;
+static const uint32_t TICK_US = 1000000 / SPEED_CTRL_HZ;
+static const int SUBSTEPS = 25;       ///< Model steps of 40 us per loop tick, under the 245 us between edges at full speed.
+static const float TICK_LAG_S = 20e-6f;   ///< Run time of a loop tick on the RP2040, the lag the predictive stop allows for.
+static const double PIO_CLOCK_HZ = 125e6;     ///< clk_sys, which the PIO state machines run at.
+static const double STALL_MAX_MS = 10.0;  ///< Contact to stall detection; the request asks for a few ms.
+
+
+struct Options {
+    double volts = 0.0;         ///< 0 keeps the model's.
+    double load = 1.0;
+    int cuts = 0;
+    const char* trace = nullptr;
+    double chatter = 0.0;       ///< Dither cycles on channel A per ms.
+    bool quiet = false;
+};
+
+#pragma region MODELS
+
+/**
+ * @brief The three state machines quad_encoder.c runs on the motor encoder: the quadrature count, edge_period with its
+ * 8 deep RX FIFO of channel A level lengths (push noblock, so a full FIFO drops them), and the limit_watch countdown of
+ * channel A edges. The M/T arithmetic on top is the firmware's (quad_velocity.c).
+ *
+ */
+struct EncoderPio {
+    quad_velocity_t vel;
+    int32_t zero = 0;               ///< Raw count that reads as position 0.
+    vector<NeedleEdge> edges;       ///< Count edges of the last model step.
+    int32_t raw = 0;                ///< Count after the edges taken so far.
+    uint64_t a_us = 0;              ///< Last channel A edge, where edge_period restarted its count.
+    uint32_t fifo[EDGE_PERIOD_FIFO];
+    uint32_t fifo_n = 0;
+    uint32_t limit_edges = 0;       ///< Edges limit_watch still waits for; 0 while it is stopped.
+
+    static int32_t levelOf(int32_t count) {
+        return (count >= 0) ? count / 2 : -((1 - count) / 2);     // floor(count / 2): channel A changes every 2 counts
+    }
+
+    /// Channel A changed at t_us. Returns true if this edge reaches an armed limit.
+    bool edgeA(uint64_t t_us) {
+        uint64_t ticks = (uint64_t)llround((t_us - a_us) * 1e-6 / vel.tick_s);
+        a_us = t_us;
+        if (fifo_n < EDGE_PERIOD_FIFO) {
+            fifo[fifo_n++] = (uint32_t)ticks - EDGE_PERIOD_OVERHEAD;   // X wraps after 2^32 counts
+        }
+        return limit_edges > 0 && --limit_edges == 0;
+    }
+
+    int32_t position() const { return vel.count - zero; }
+};
+
+#pragma endregion
+
+#pragma region WORLD
+
+static Options opt;
+static NeedleModel motor;
+static EncoderPio enc;
+static speed_loop_t loop;
+static bool bridge_dir = MOTOR_FW;     ///< Last setMotor().
+static uint16_t bridge_pwm = 0;
+static mt19937 rng(1);
+static uint64_t now_us = 0;
+static double pot_pct = 50.0;
+static double obstacle_rev = 1e9;      ///< Output revolution of a hard obstacle in the tissue.
+
+static vector<log_record_t> records;
+static vector<uint8_t> sent;
+static FILE* trace = nullptr;
+
+static double noise(double sd) {
+    return normal_distribution<double>(0.0, sd)(rng);
+}
+
+#pragma endregion
+
+#pragma region HAL
+
+void hal_speed_set(bool direction, float target_rpm) {
+    speed_loop_set(&loop, direction, target_rpm);
+}
+
+void hal_speed_open_loop(bool direction, uint16_t power) {
+    speed_loop_open_loop(&loop, direction, power);
+}
+
+void hal_speed_stop() {
+    speed_loop_stop(&loop);
+}
+
+void hal_speed_limit(int32_t limit) {
+    speed_loop_limit(&loop, limit);
+}
+
+void hal_speed_clear_limit() {
+    speed_loop_clear_limit(&loop);
+}
+
+bool hal_speed_at_limit() {
+    return speed_loop_at_limit(&loop);
+}
+
+void hal_speed_zero() {
+    speed_loop_zero(&loop);
+}
+
+/**
+ * @brief Writes the records of the run to the --trace file. Done between runs, so it stays out of the benchmark.
+ *
+ */
+static void flushTrace() {
+    for (const log_record_t& rec : records) {
+        if (trace) {
+            fprintf(trace, "%s,%lu,%f,%f,%f,%f,%f,%f,%u\n", rec.state == CUTTING ? "CUTTING" : "EXITING",
+                    (unsigned long)(rec.time_us / 1000), rec.current_mA.to_float(), rec.lp_current.to_float(),
+                    rec.maf_current.to_float(), rec.rpm, rec.displacement.to_float(), rec.force.to_float(), rec.pwm);
+        }
+    }
+}
+
+void hal_log(log_record_t* rec) {
+    records.push_back(*rec);
+}
+
+void hal_send(uint8_t kind) {
+    sent.push_back(kind);
+}
+
+void hal_run_start() {
+    flushTrace();
+    records.clear();
+    loop.stats = speed_control_stats_t();
+}
+
+void hal_run_finish() {
+}
+
+#pragma endregion
+
+#pragma region SPEED HAL
+
+/**
+ * @brief The hard limit interrupt: motorOff(), then the loop's callback.
+ *
+ */
+static void limitTrip() {
+    enc.limit_edges = 0;
+    bridge_pwm = 0;
+    speed_loop_trip(&loop);
+}
+
+float speed_hal_velocity(uint32_t now) {
+    float cps = quad_velocity_update(&enc.vel, motor.count, now, enc.fifo, enc.fifo_n);
+    enc.fifo_n = 0;
+    return cps;
+}
+
+int32_t speed_hal_position() {
+    return enc.position();
+}
+
+void speed_hal_zero() {
+    enc.zero = enc.vel.count;
+}
+
+void speed_hal_arm_limit(int32_t position, int32_t limit, bool increasing) {
+    enc.limit_edges = quad_limit_edges(position, limit, increasing);
+    if (enc.limit_edges == 0) {
+        limitTrip();
+    }
+}
+
+void speed_hal_disarm_limit() {
+    enc.limit_edges = 0;
+}
+
+void speed_hal_motor(bool direction, uint16_t pwm) {
+    bridge_dir = direction;
+    bridge_pwm = pwm;
+}
+
+uint32_t speed_hal_lock() {
+    return 0;       // the tick and the PIO model never run into each other here
+}
+
+void speed_hal_unlock(uint32_t) {
+}
+
+#pragma endregion
+
+#pragma region RATE GROUPS
+
+struct Bench {
+    double ns = 0.0;
+    uint64_t calls = 0;
+};
+
+static Bench benchTick, benchCurrent;
+static double benchOverhead = 0.0;
+
+template <typename Fn>
+static void timed(Bench& b, Fn fn) {
+    auto t0 = chrono::steady_clock::now();
+    fn();
+    auto t1 = chrono::steady_clock::now();
+    b.ns += chrono::duration<double, nano>(t1 - t0).count();
+    b.calls++;
+}
+
+static void currentGroup() {
+    static uint32_t polls = 0;
+    // Every 50th read finds the bus busy and the previous value is held.
+    bool fresh = (++polls % 50) != 0;
+    int32_t reg = motor.ina219Raw(bridge_pwm, INA219_MAX_AMPS / 32768, 0.002);
+    timed(benchCurrent, [&] { control_current(fresh, inaToMilliamps(reg), bridge_pwm, (uint32_t)now_us); });
+}
+
+static void forceGroup() {
+    static uint32_t samples = 0;
+    int32_t bridge = motor.fx29Raw(FX29_ZERO_COUNTS, FX29_N_PER_COUNT, 3.0);
+    if (++samples % 97 == 0) {
+        bridge = (bridge + 800) & 0x3fff;      // Single sample spike, for the median.
+    }
+    control_force(fx29ToNewtons(bridge));
+}
+
+static void inputGroup() {
+    double potAdc = (pot_pct - 1.0) / POT_SPEED_PER_ADC + noise(2.0);
+    long speed = potToSpeed(q16_t::from_double(potAdc)).to_int();
+    double batAdc = 4095 / 3.3 * (motor.p.volts / 2.0 / 2.0) + noise(2.0);
+    control_inputs(speed, batteryPercent(q16_t::from_double(batAdc)).to_int());
+}
+
+/**
+ * @brief Advances the world by one loop period: speed loop tick, motor, then the rate groups due at this time.
+ *
+ */
+static void step() {
+    speed_loop_tick(&loop, (uint32_t)now_us, TICK_LAG_S);
+    motor.hi_wall = obstacle_rev * COUNTS_PER_REV;
+
+    double dt = TICK_US * 1e-6 / SUBSTEPS;
+    for (int k = 0; k < SUBSTEPS; k++) {
+        motor.step(bridge_dir, bridge_pwm, dt);
+        for (const NeedleEdge& e : enc.edges) {
+            bool a = EncoderPio::levelOf(e.count) != EncoderPio::levelOf(enc.raw);
+            enc.raw = e.count;
+            if (a && enc.edgeA(e.t_us)) {
+                limitTrip();
+            }
+        }
+        enc.edges.clear();
+        if (opt.chatter > 0.0 && uniform_real_distribution<double>(0.0, 1.0)(rng) < opt.chatter * dt * 1e3) {
+            // One dither cycle: A goes and comes back, which quadrature decoding rejects.
+            uint64_t t = max(enc.a_us, (uint64_t)llround(motor.t * 1e6) - 1);
+            for (int edge = 0; edge < 2; edge++) {
+                if (enc.edgeA(t + edge)) {
+                    limitTrip();
+                }
+            }
+        }
+    }
+    now_us += TICK_US;
+
+    uint64_t tick = now_us / TICK_US;
+    timed(benchTick, [] { control_tick(loop.position, loop.speed_rpm, bridge_dir, bridge_pwm, (uint32_t)now_us); });
+    if (tick % (SPEED_CTRL_HZ / CURRENT_HZ) == 0) {
+        currentGroup();
+    }
+    if (tick % (SPEED_CTRL_HZ / FORCE_HZ) == 0) {
+        forceGroup();
+    }
+    if (tick % (SPEED_CTRL_HZ / DISPLAY_HZ) == 0) {
+        inputGroup();
+    }
+}
+
+/**
+ * @brief Steps until done() holds or timeout_s of simulated time has passed.
+ *
+ */
+template <typename Fn>
+static bool runUntil(Fn done, double timeout_s) {
+    uint64_t end = now_us + (uint64_t)(timeout_s * 1e6);
+    while (!done()) {
+        if (now_us >= end) {
+            return false;
+        }
+        step();
+    }
+    return true;
+}
+
+static void settle() {
+    runUntil([] { return false; }, 0.3);
+}
+
+#pragma endregion
+
+#pragma region PROCEDURE
+
+static int failures = 0;
+
+static void check(bool ok, const char* what, double pct) {
+    if (!ok) {
+        printf("FAIL: %s at %.0f %%\n", what, pct);
+        failures++;
+    }
+}
+
+/**
+ * @brief Checks the records of one run: only cutting or exiting samples, evenly spaced at CURRENT_HZ within a state.
+ *
+ */
+static bool recordsOk() {
+    if (records.size() < 2) {
+        return false;
+    }
+    for (size_t k = 0; k < records.size(); k++) {
+        if (records[k].state != CUTTING && records[k].state != EXITING) {
+            return false;
+        }
+        if (k > 0 && records[k].state == records[k - 1].state && records[k].time_us - records[k - 1].time_us != 1000000 / CURRENT_HZ) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief A full procedure at one potentiometer setting. Starts in FINISH or WAIT and ends in FINISH after homing.
+ *
+ */
+static void procedure(double pct) {
+    pot_pct = pct;
+    obstacle_rev = 1e9;
+
+    // To STANDBY and let the speed potentiometer be read.
+    control_release();
+    check(state == STANDBY, "release into STANDBY", pct);
+    settle();
+
+    // Cut to fwRev.
+    control_release();
+    check(state == CUTTING, "release into CUTTING", pct);
+    float target = targetRpm;
+    double travel_s = 2.0 * (fwRev - bwRev) / target * 60.0 + 2.0;    ///< Twice the time a move should take.
+    double rpmSum = 0.0;
+    int rpmN = 0;
+    bool ended = runUntil([&] {
+        double rev = motor.counts / COUNTS_PER_REV;
+        if (state == CUTTING && rev > 0.2 * fwRev && rev < 0.8 * fwRev) {
+            rpmSum += rpm;
+            rpmN++;
+        }
+        return state != CUTTING;
+    }, travel_s);
+    check(ended && state == REMOVAL, "cut ends in REMOVAL", pct);
+    settle();
+    double meanRpm = rpmN ? rpmSum / rpmN : 0.0;
+    double cutErr = (motor.counts - enc.zero - getCounts(fwRev)) * UM_PER_COUNT;
+    check(fabs(meanRpm - target) <= 0.05 * target, "cutting speed within 5 % of target", pct);
+    check(fabs(cutErr) <= 50.0, "cut lands within 50 um of fwRev", pct);
+
+    // Back to bwRev.
+    control_release();
+    check(state == EXITING, "release into EXITING", pct);
+    ended = runUntil([] { return state != EXITING; }, travel_s);
+    check(ended && state == FINISH, "exit ends in FINISH", pct);
+    settle();
+    double exitErr = (motor.counts - enc.zero - getCounts(bwRev)) * UM_PER_COUNT;
+    check(fabs(exitErr) <= 50.0, "exit lands within 50 um of bwRev", pct);
+    size_t logged = records.size();
+    check(recordsOk(), "log records evenly spaced and cutting or exiting only", pct);
+    check(!sent.empty() && sent.back() == MSG_CLOSE_LOG, "log closed at FINISH", pct);
+
+    // Cut into an obstacle half way: the stall detector has to end the cut.
+    control_release();
+    settle();
+    obstacle_rev = (enc.zero / COUNTS_PER_REV) + 0.5 * fwRev;
+    control_release();
+    uint32_t detections = stall.detections;
+    uint64_t contactUs = 0;
+    ended = runUntil([&contactUs] {
+        if (contactUs == 0 && motor.counts >= motor.hi_wall) {
+            contactUs = now_us;
+        }
+        return state != CUTTING;
+    }, travel_s);
+    bool stallOk = ended && state == REMOVAL && stall.detections == detections + 1 && contactUs != 0;
+    check(stallOk, "obstacle stops the cut through the stall detector", pct);
+    double stallMs = (now_us - contactUs) / 1000.0;
+    check(stallMs <= STALL_MAX_MS, "stall detected within STALL_MAX_MS of contact", pct);
+    settle();
+    obstacle_rev = 1e9;
+    control_release();
+    ended = runUntil([] { return state != EXITING; }, travel_s);
+    check(ended && state == FINISH, "exit after the obstacle ends in FINISH", pct);
+
+    // Home into the housing 2 revolutions behind the start.
+    motor.lo_wall = enc.zero - 2.0 * COUNTS_PER_REV;
+    control_hold();
+    ended = runUntil([] { return state != ZERO; }, 10.0);
+    settle();
+    bool homeOk = ended && state == FINISH && count == 0 && enc.position() == 0;
+    check(homeOk, "homing stops at the housing and zeroes the position", pct);
+
+    if (!opt.quiet) {
+        printf("%5.0f %7.1f %8.1f %+8.1f %+8.1f %6zu %7s %6.1f %5s\n", pct, target, meanRpm, cutErr, exitErr, logged,
+               stallOk ? "yes" : "no", stallMs, homeOk ? "yes" : "no");
+    }
+}
+
+/**
+ * @brief --cuts: n cuts and exits at full speed into tissue of random hardness. Returns the landing errors in um and
+ * checks them against the same 50 um as procedure().
+ *
+ */
+static void batch(int n, vector<double>* cutErr, vector<double>* exitErr) {
+    uniform_real_distribution<double> hardness(0.5, 2.0);
+    pot_pct = 100.0;
+    double base = motor.tissue_scale;
+    for (int k = 0; k < n; k++) {
+        motor.tissue_scale = base * hardness(rng);
+        control_release();
+        runUntil([] { return false; }, 0.2);
+        control_release();
+        double travel_s = 2.0 * (fwRev - bwRev) / targetRpm * 60.0 + 2.0;
+        bool ended = runUntil([] { return state != CUTTING; }, travel_s);
+        check(ended && state == REMOVAL, "cut ends in REMOVAL", pot_pct);
+        runUntil([] { return motor.w == 0.0; }, 0.3);
+        cutErr->push_back((motor.counts - enc.zero - getCounts(fwRev)) * UM_PER_COUNT);
+        check(fabs(cutErr->back()) <= 50.0, "cut lands within 50 um of fwRev", pot_pct);
+
+        control_release();
+        ended = runUntil([] { return state != EXITING; }, travel_s);
+        check(ended && state == FINISH, "exit ends in FINISH", pot_pct);
+        runUntil([] { return motor.w == 0.0; }, 0.3);
+        exitErr->push_back((motor.counts - enc.zero - getCounts(bwRev)) * UM_PER_COUNT);
+        check(fabs(exitErr->back()) <= 50.0, "exit lands within 50 um of bwRev", pot_pct);
+    }
+}
+
+static void printErrors(const char* what, const vector<double>& err) {
+    double sum = 0.0, worst = 0.0;
+    for (double e : err) {
+        sum += fabs(e);
+        worst = fmax(worst, fabs(e));
+    }
+    printf("%s landing error: mean |e| %.1f um, max |e| %.1f um over %zu runs\n", what, sum / err.size(), worst,
+           err.size());
+}
+
+#pragma endregion
+
+static void usage() {
+    fprintf(stderr, "usage: host_sim [--model model.csv] [--tissue tissue.csv] [--volts V] [--load SCALE] [--cuts N] "
+                    "[--trace out.csv] [--chatter RATE] [--quiet]\n");
+}
+
+int main(int argc, char** argv) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--model" && i + 1 < argc) {
+            if (!needle_params_load(argv[++i], &motor.p)) {
+                fprintf(stderr, "%s: cannot read\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--tissue" && i + 1 < argc) {
+            if (!tissue_load(argv[++i], &motor.tissue)) {
+                fprintf(stderr, "%s: cannot read\n", argv[i]);
+                return 1;
+            }
+        } else if (arg == "--volts" && i + 1 < argc) {
+            opt.volts = atof(argv[++i]);
+        } else if (arg == "--load" && i + 1 < argc) {
+            opt.load = atof(argv[++i]);
+        } else if (arg == "--cuts" && i + 1 < argc) {
+            opt.cuts = atoi(argv[++i]);
+        } else if (arg == "--trace" && i + 1 < argc) {
+            opt.trace = argv[++i];
+        } else if (arg == "--chatter" && i + 1 < argc) {
+            opt.chatter = atof(argv[++i]);
+        } else if (arg == "--quiet") {
+            opt.quiet = true;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (opt.volts > 0.0) {
+        motor.p.volts = opt.volts;
+    }
+    motor.tissue_scale = opt.load;
+    if (opt.trace) {
+        trace = fopen(opt.trace, "w");
+        if (!trace) {
+            fprintf(stderr, "%s: cannot create\n", opt.trace);
+            return 1;
+        }
+        fprintf(trace, "State, Time(ms), Current(mA), CurrentLP(mA), CurrentMAF(mA), RPM, Displacement(mm), Force(N), PWM\n");
+    }
+
+    static constexpr speed_pid_config_t speedCfg = {SPEED_KP, SPEED_KI, SPEED_KD, SPEED_KFF, SPEED_FF0, SPEED_SLEW,
+                                                    (float)MOTOR_ON, SPEED_D_ALPHA};
+    const stop_config_t stopCfg = {STOP_COAST_S, STOP_COAST_MIN, STOP_COAST_MAX, STOP_LEARN};
+    speed_loop_init(&loop, &speedCfg, &stopCfg);
+    quad_velocity_init(&enc.vel, (float)(2.0 / PIO_CLOCK_HZ), ENCODER_ZERO_US, 0);
+    motor.edges = &enc.edges;
+    control_init();
+
+    // Time a bare clock read pair, to take it off the benchmark.
+    Bench empty;
+    for (int k = 0; k < 100000; k++) {
+        timed(empty, [] {});
+    }
+    benchOverhead = empty.ns / empty.calls;
+
+    auto wall0 = chrono::steady_clock::now();
+    runUntil([] { return false; }, 0.2);
+    if (opt.cuts > 0) {
+        vector<double> cutErr, exitErr;
+        batch(opt.cuts, &cutErr, &exitErr);
+        printErrors("cut", cutErr);
+        printErrors("exit", exitErr);
+    } else {
+        if (!opt.quiet) {
+            printf("%.1f V, load %.2f; landing errors in um, stall ms from contact to detection\n", motor.p.volts, opt.load);
+            printf("%5s %7s %8s %8s %8s %6s %7s %6s %5s\n", "pot %", "target", "mean rpm", "cut", "exit", "log",
+                   "stall", "ms", "home");
+        }
+        for (double pct : {30.0, 60.0, 100.0}) {
+            procedure(pct);
+        }
+    }
+    double wall = chrono::duration<double>(chrono::steady_clock::now() - wall0).count();
+
+    printf("simulated %.1f s in %.2f s (%.0fx real time), %u hard limit trips\n", now_us * 1e-6, wall,
+           now_us * 1e-6 / wall, (unsigned)loop.stats.limit_trips);
+    if (opt.cuts > 0) {
+        printf("%.0f cuts per minute\n", opt.cuts / wall * 60.0);
+    }
+    printf("control_tick %.0f ns, control_current %.0f ns per call on this host\n",
+           benchTick.ns / benchTick.calls - benchOverhead, benchCurrent.ns / benchCurrent.calls - benchOverhead);
+    if (trace) {
+        flushTrace();
+        fclose(trace);
+    }
+    printf("%s: %d failed checks\n", failures ? "FAIL" : "PASS", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,734 @@
+/**
+ * @file model_fit.cpp
+ * @author Thomas Chang
+ * @brief Fits the needle drive model (needle_model.h) to recorded runs.
+ * @details Usage:
+ *
+ *     model_fit [--volts V] [-o model.csv] [--tissue tissue.csv] [--check] dataN.csv...
+ *
+ * Reads CSV run logs as the firmware wrote them or runlog_convert produces them (State, Time(ms), Current(mA), RPM,
+ * Displacement(mm), Force(N), PWM; other columns are ignored) and fits, by least squares over the CUTTING and EXITING
+ * samples:
+ *
+ *  - R and ke from the averaged winding circuit, d V = R i + ke w, with d the duty, i = Current / d the winding current
+ *    and w the motor speed. V is the battery voltage, which the log does not hold (--volts, 7.4 V by default).
+ *  - J, b, tc and kf from the torque balance, ke i = J dw/dt + b w + tc + kf |F|, with kt = ke (SI units). Terms that
+ *    come out negative are dropped and the rest refitted, and so are blocks far off the fit, like a stall.
+ *  - The tissue table: the median force of every cut in 0.02 mm bins of displacement, lined up between the cuts, then
+ *    thinned to the points that keep the line within 0.05 N; and the retract fraction from the exiting samples.
+ *
+ * Both equations are fitted on samples averaged over up to 0.1 s, leaving out where the back EMF reaches the applied
+ * voltage: the current the INA219 reads does not say which way it flows, so braking there would look like driving.
+ *
+ * L is not observable at the log rate and keeps its default. The parameters go to model.csv and the table to
+ * tissue.csv, for host_sim --model and --tissue. Each run is then replayed through the model with the logged PWM and
+ * force, and the RMS error of speed and current is printed for the default and the fitted parameters.
+ *
+ * --check is for a host_sim --trace without --model and --tissue: the fit has to come back with the default
+ * parameters within 10 %, the puncture peak of the standard tissue within 5 % and a replay error at most 10 % above
+ * the defaults'. The tool prints PASS or FAIL and exits with 1 if any of them fails.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "needle_model.h"
+
+#include "config.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const double BIN_MM = 0.02;      ///< Depth bin of the tissue table before thinning.
+static const double TABLE_TOL_N = 0.05; ///< The tissue table drops points that lie this close to its line.
+static const double ALIGN_MM = 5.0;     ///< Cuts are shifted by up to this much to line up with the first.
+static const double MIN_DUTY = 0.1;     ///< Below this the current is too small to divide by the duty.
+static const double MIN_DRIVE = 0.05;   ///< The winding voltage, d V - ke w, must be at least this fraction of d V.
+static const double BLOCK_S = 0.1;      ///< Samples are averaged over at most this long before fitting.
+static const double BLOCK_FORCE_N = 0.5; ///< A block ends where the force leaves this band around its first sample.
+static const double OUTLIER_RMS = 5.0;  ///< Torque balance blocks off by more than this many RMS residuals are dropped.
+
+/**
+ * @brief One logged sample, in SI units where the model needs them.
+ *
+ */
+struct Sample {
+    bool cutting;
+    double t;           ///< s
+    double amps;        ///< Supply current.
+    double rpm;         ///< Output speed, magnitude.
+    double mm;          ///< Displacement.
+    double force;       ///< N, magnitude.
+    double pwm;
+};
+
+/**
+ * @brief The samples of one run, split where the state changes or the log has a gap.
+ *
+ */
+struct Run {
+    string path;
+    vector<vector<Sample>> segments;
+};
+
+#pragma region CSV
+
+static string trim(const string& s) {
+    size_t a = s.find_first_not_of(" \t\r\n");
+    size_t b = s.find_last_not_of(" \t\r\n");
+    return a == string::npos ? "" : s.substr(a, b - a + 1);
+}
+
+static vector<string> split(const string& line) {
+    vector<string> out;
+    size_t start = 0;
+    while (true) {
+        size_t comma = line.find(',', start);
+        out.push_back(trim(line.substr(start, comma == string::npos ? string::npos : comma - start)));
+        if (comma == string::npos) {
+            return out;
+        }
+        start = comma + 1;
+    }
+}
+
+static bool readRun(const string& path, Run* run) {
+    FILE* in = fopen(path.c_str(), "r");
+    if (!in) {
+        fprintf(stderr, "%s: cannot open\n", path.c_str());
+        return false;
+    }
+    run->path = path;
+
+    // Columns by name, without the unit.
+    enum { STATE, TIME, CURRENT, RPM, DISP, FORCE, PWM, COLUMNS };
+    static const char* const names[COLUMNS] = {"State", "Time", "Current", "RPM", "Displacement", "Force", "PWM"};
+    int col[COLUMNS];
+    fill(col, col + COLUMNS, -1);
+
+    char buf[512];
+    if (!fgets(buf, sizeof(buf), in)) {
+        fprintf(stderr, "%s: empty\n", path.c_str());
+        fclose(in);
+        return false;
+    }
+    vector<string> header = split(buf);
+    for (size_t k = 0; k < header.size(); k++) {
+        string name = header[k].substr(0, header[k].find('('));
+        for (int c = 0; c < COLUMNS; c++) {
+            if (col[c] < 0 && name == names[c]) {
+                col[c] = (int)k;
+            }
+        }
+    }
+    for (int c = 0; c < COLUMNS; c++) {
+        if (col[c] < 0) {
+            fprintf(stderr, "%s: no %s column\n", path.c_str(), names[c]);
+            fclose(in);
+            return false;
+        }
+    }
+
+    vector<Sample>* seg = nullptr;
+    while (fgets(buf, sizeof(buf), in)) {
+        vector<string> f = split(buf);
+        if (f.size() < header.size()) {
+            continue;
+        }
+        Sample s;
+        if (f[col[STATE]] == "CUTTING") {
+            s.cutting = true;
+        } else if (f[col[STATE]] == "EXITING") {
+            s.cutting = false;
+        } else {
+            continue;
+        }
+        s.t = atof(f[col[TIME]].c_str()) * 1e-3;
+        s.amps = atof(f[col[CURRENT]].c_str()) * 1e-3;
+        s.rpm = fabs(atof(f[col[RPM]].c_str()));
+        s.mm = atof(f[col[DISP]].c_str());
+        s.force = fabs(atof(f[col[FORCE]].c_str()));
+        s.pwm = atof(f[col[PWM]].c_str());
+        // A new segment on a state change or a gap of more than 10 samples.
+        if (!seg || seg->back().cutting != s.cutting || s.t <= seg->back().t || s.t - seg->back().t > 10.0 / CURRENT_HZ) {
+            run->segments.emplace_back();
+            seg = &run->segments.back();
+        }
+        seg->push_back(s);
+    }
+    fclose(in);
+    return true;
+}
+
+#pragma endregion
+
+#pragma region FIT
+
+/**
+ * @brief Least squares: the x that minimises |A x - y|, by the normal equations. Columns whose coefficient comes out
+ * negative are dropped (fixed at 0) and the rest refitted.
+ *
+ */
+static vector<double> leastSquares(const vector<vector<double>>& A, const vector<double>& y, size_t n) {
+    vector<bool> active(n, true);
+    vector<double> x(n, 0.0);
+    for (size_t pass = 0; pass < n; pass++) {
+        vector<size_t> cols;
+        for (size_t c = 0; c < n; c++) {
+            if (active[c]) {
+                cols.push_back(c);
+            }
+        }
+        size_t m = cols.size();
+        if (m == 0) {
+            return x;
+        }
+        // Normal equations, scaled by the column norms so that the physical units do not ruin the conditioning.
+        vector<double> scale(m, 0.0);
+        for (const auto& row : A) {
+            for (size_t a = 0; a < m; a++) {
+                scale[a] += row[cols[a]] * row[cols[a]];
+            }
+        }
+        for (double& s : scale) {
+            s = s > 0.0 ? 1.0 / sqrt(s) : 1.0;
+        }
+        vector<vector<double>> M(m, vector<double>(m + 1, 0.0));
+        for (size_t r = 0; r < A.size(); r++) {
+            for (size_t a = 0; a < m; a++) {
+                double va = A[r][cols[a]] * scale[a];
+                for (size_t b = 0; b < m; b++) {
+                    M[a][b] += va * A[r][cols[b]] * scale[b];
+                }
+                M[a][m] += va * y[r];
+            }
+        }
+        // Gaussian elimination with partial pivoting.
+        for (size_t a = 0; a < m; a++) {
+            size_t piv = a;
+            for (size_t r = a + 1; r < m; r++) {
+                if (fabs(M[r][a]) > fabs(M[piv][a])) {
+                    piv = r;
+                }
+            }
+            swap(M[a], M[piv]);
+            if (fabs(M[a][a]) < 1e-12) {
+                return vector<double>(n, NAN);
+            }
+            for (size_t r = 0; r < m; r++) {
+                if (r != a) {
+                    double k = M[r][a] / M[a][a];
+                    for (size_t c = a; c <= m; c++) {
+                        M[r][c] -= k * M[a][c];
+                    }
+                }
+            }
+        }
+        bool negative = false;
+        fill(x.begin(), x.end(), 0.0);
+        for (size_t a = 0; a < m; a++) {
+            x[cols[a]] = M[a][m] / M[a][a] * scale[a];
+            if (x[cols[a]] < 0.0) {
+                active[cols[a]] = false;
+                negative = true;
+            }
+        }
+        if (!negative) {
+            return x;
+        }
+    }
+    return x;
+}
+
+static double motorRadS(const NeedleParams& p, double rpm) {
+    return rpm * p.gear * 2.0 * M_PI / 60.0;
+}
+
+/**
+ * @brief Averages of the driven, motoring samples over up to BLOCK_S. Both model equations are linear, so they hold
+ * for the averages as they do for the samples, with a fraction of the sensor noise; fitted on single samples, the
+ * INA219 and M/T noise in the regressors biases R toward 0.
+ *
+ * The INA219 measures the supply current, which is |i| d whichever way the winding current flows. Where the back EMF
+ * reaches the applied voltage, as when the speed loop slows the motor, the winding current reverses and the bridge
+ * feeds it back, while i = Current / d still comes out positive; those samples would add the braking torque with the
+ * wrong sign and pull J and kf down, so blocks whose winding voltage is not clearly positive are left out. A force
+ * that leaves the band of BLOCK_FORCE_N around the first sample ends the block, which keeps the puncture from being
+ * averaged into the blocks around it, and the speed change comes from a line through all speeds, not the two ends.
+ *
+ */
+struct Block {
+    double i;           ///< Winding current, A.
+    double w;           ///< Motor speed, rad/s.
+    double u;           ///< Duty times volts.
+    double accel;       ///< dw/dt: slope of the least squares line through the speeds of the block.
+    double force;
+};
+
+/**
+ * @brief The blocks of all runs. ke is the back EMF constant of the motoring check; 0 skips the check.
+ *
+ */
+static vector<Block> blocks(const vector<Run>& runs, const NeedleParams& p, double ke) {
+    vector<Block> out;
+    for (const Run& run : runs) {
+        for (const auto& seg : run.segments) {
+            size_t first = 0;
+            while (first < seg.size()) {
+                Block b = {};
+                double st = 0.0, stt = 0.0, stw = 0.0;     // sums for the slope of w over t
+                size_t k = first;
+                bool full = false;
+                for (; k < seg.size(); k++) {
+                    const Sample& s = seg[k];
+                    double d = s.pwm / MOTOR_ON;
+                    double w = motorRadS(p, s.rpm);
+                    double t = s.t - seg[first].t;
+                    if (d < MIN_DUTY || s.rpm <= 0.0 || fabs(s.force - seg[first].force) > BLOCK_FORCE_N) {
+                        break;
+                    }
+                    if (t >= BLOCK_S) {
+                        full = true;
+                        break;
+                    }
+                    b.i += s.amps / d;
+                    b.w += w;
+                    b.u += d * p.volts;
+                    b.force += s.force;
+                    st += t;
+                    stt += t * t;
+                    stw += t * w;
+                }
+                // Shorter blocks, cut by the checks above, still hold enough samples to average.
+                size_t n = k - first;
+                if (n >= 4 && (full || seg[k - 1].t - seg[first].t >= BLOCK_S / 2)) {
+                    b.i /= n;
+                    b.w /= n;
+                    b.u /= n;
+                    b.force /= n;
+                    b.accel = (stw - st * b.w) / (stt - st * st / n);
+                    if (b.u - ke * b.w >= MIN_DRIVE * b.u) {
+                        out.push_back(b);
+                    }
+                }
+                first = (k > first) ? k : k + 1;
+            }
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Fits R, ke (= kt), J, b, tc and kf. Returns false if the runs do not pin them down.
+ *
+ */
+static bool fitMotor(const vector<Run>& runs, NeedleParams* p) {
+    // The motoring check needs ke: a first fit over all driven blocks, then one over the motoring blocks.
+    vector<Block> bl;
+    vector<vector<double>> A;
+    vector<double> y;
+    for (int pass = 0; pass < 2; pass++) {
+        bl = blocks(runs, *p, pass == 0 ? 0.0 : p->ke);
+        if (bl.size() < 10) {
+            fprintf(stderr, "too few driven blocks (%zu)\n", bl.size());
+            return false;
+        }
+        A.clear();
+        y.clear();
+        for (const Block& b : bl) {
+            A.push_back({b.i, b.w});
+            y.push_back(b.u);
+        }
+        vector<double> elec = leastSquares(A, y, 2);
+        if (!(elec[0] > 0.0 && elec[1] > 0.0)) {
+            fprintf(stderr, "R and ke do not fit; are --volts and the logs right?\n");
+            return false;
+        }
+        p->R = elec[0];
+        p->ke = p->kt = elec[1];
+    }
+
+    A.clear();
+    y.clear();
+    for (const Block& b : bl) {
+        A.push_back({b.accel, b.w, 1.0, b.force});
+        y.push_back(p->kt * b.i);
+    }
+    vector<double> mech = leastSquares(A, y, 4);
+    // Blocks far off the fit hold a torque the model does not have, like a stall against a hard stop; refit without.
+    if (!std::isnan(mech[0])) {
+        vector<double> res(A.size());
+        double sq = 0.0;
+        for (size_t r = 0; r < A.size(); r++) {
+            res[r] = y[r] - (mech[0] * A[r][0] + mech[1] * A[r][1] + mech[2] * A[r][2] + mech[3] * A[r][3]);
+            sq += res[r] * res[r];
+        }
+        double limit = OUTLIER_RMS * sqrt(sq / A.size());
+        vector<vector<double>> keptA;
+        vector<double> keptY;
+        for (size_t r = 0; r < A.size(); r++) {
+            if (fabs(res[r]) <= limit) {
+                keptA.push_back(A[r]);
+                keptY.push_back(y[r]);
+            }
+        }
+        mech = leastSquares(keptA, keptY, 4);
+    }
+    if (std::isnan(mech[0]) || mech[0] <= 0.0) {
+        fprintf(stderr, "inertia does not fit; the runs need speed changes\n");
+        return false;
+    }
+    p->J = mech[0];
+    p->b = mech[1];
+    p->tc = mech[2];
+    p->kf = mech[3];
+    return true;
+}
+
+static double median(vector<double>& v) {
+    size_t h = v.size() / 2;
+    nth_element(v.begin(), v.begin() + h, v.end());
+    if (v.size() % 2 != 0) {
+        return v[h];
+    }
+    return (v[h] + *max_element(v.begin(), v.begin() + h)) / 2.0;
+}
+
+/**
+ * @brief Median force of one cut in BIN_MM bins of displacement; NAN where the bin holds fewer than 3 samples.
+ *
+ */
+static vector<double> cutProfile(const vector<Sample>& seg) {
+    vector<vector<double>> bins;
+    for (const Sample& s : seg) {
+        if (s.mm >= 0.0) {
+            size_t b = (size_t)(s.mm / BIN_MM);
+            if (b >= bins.size()) {
+                bins.resize(b + 1);
+            }
+            bins[b].push_back(s.force);
+        }
+    }
+    vector<double> out(bins.size(), NAN);
+    for (size_t b = 0; b < bins.size(); b++) {
+        if (bins[b].size() >= 3) {
+            out[b] = median(bins[b]);
+        }
+    }
+    return out;
+}
+
+/**
+ * @brief Bins to add to the depth of a cut so that its profile lines up with the reference: the shift, up to
+ * ALIGN_MM either way, with the least mean square difference where both have a value.
+ *
+ */
+static int alignCut(const vector<double>& cut, const vector<double>& ref) {
+    int range = (int)lround(ALIGN_MM / BIN_MM);
+    int best = 0;
+    double bestErr = INFINITY;
+    for (int shift = -range; shift <= range; shift++) {
+        double sq = 0.0;
+        size_t n = 0;
+        for (size_t b = 0; b < cut.size(); b++) {
+            long r = (long)b + shift;
+            if (r >= 0 && r < (long)ref.size() && !std::isnan(cut[b]) && !std::isnan(ref[r])) {
+                sq += (cut[b] - ref[r]) * (cut[b] - ref[r]);
+                n++;
+            }
+        }
+        if (n > cut.size() / 2 && sq / n < bestErr) {
+            bestErr = sq / n;
+            best = shift;
+        }
+    }
+    return best;
+}
+
+/**
+ * @brief Drops the points of a table that lie within TABLE_TOL_N of the line through their neighbours: between two
+ * kept points, the one farthest off their chord is kept while it lies more than that off. A peak is the farthest
+ * point of its span, so it stays.
+ *
+ */
+static TissueProfile thin(const TissueProfile& fine) {
+    vector<bool> keep(fine.depth_mm.size(), false);
+    vector<pair<size_t, size_t>> spans;
+    if (!keep.empty()) {
+        keep.front() = keep.back() = true;
+        spans.push_back({0, keep.size() - 1});
+    }
+    while (!spans.empty()) {
+        size_t a = spans.back().first, b = spans.back().second;
+        spans.pop_back();
+        size_t worst = a;
+        double off = TABLE_TOL_N;
+        for (size_t k = a + 1; k < b; k++) {
+            double f = (fine.depth_mm[k] - fine.depth_mm[a]) / (fine.depth_mm[b] - fine.depth_mm[a]);
+            double e = fabs(fine.force_N[k] - (fine.force_N[a] + f * (fine.force_N[b] - fine.force_N[a])));
+            if (e > off) {
+                worst = k;
+                off = e;
+            }
+        }
+        if (worst != a) {
+            keep[worst] = true;
+            spans.push_back({a, worst});
+            spans.push_back({worst, b});
+        }
+    }
+    TissueProfile t;
+    for (size_t k = 0; k < keep.size(); k++) {
+        if (keep[k]) {
+            t.depth_mm.push_back(fine.depth_mm[k]);
+            t.force_N.push_back(fine.force_N[k]);
+        }
+    }
+    return t;
+}
+
+/**
+ * @brief Tissue table from the cutting samples and the retract fraction from the exiting ones.
+ *
+ * The tissue does not sit at the same displacement in every procedure, so every cut is shifted onto the first before
+ * the median over the cuts is taken in each bin; pooled as they come, the cuts smear the puncture out. Each cut
+ * counts once per bin, however slowly it went. Exiting samples take the shift of the cut before them.
+ *
+ */
+static TissueProfile fitTissue(const vector<Run>& runs, NeedleParams* p) {
+    vector<vector<double>> bins;
+    vector<double> ref;
+    vector<vector<int>> shifts;     // per run and segment, in bins
+    for (const Run& run : runs) {
+        shifts.emplace_back();
+        int shift = 0;
+        for (const auto& seg : run.segments) {
+            if (seg.front().cutting) {
+                vector<double> cut = cutProfile(seg);
+                if (ref.empty()) {
+                    ref = cut;
+                }
+                shift = alignCut(cut, ref);
+                for (size_t b = 0; b < cut.size(); b++) {
+                    long r = (long)b + shift;
+                    if (r < 0 || std::isnan(cut[b])) {
+                        continue;
+                    }
+                    if (r >= (long)bins.size()) {
+                        bins.resize(r + 1);
+                    }
+                    bins[r].push_back(cut[b]);
+                }
+            }
+            shifts.back().push_back(shift);
+        }
+    }
+    TissueProfile fine;
+    for (size_t b = 0; b < bins.size(); b++) {
+        if (!bins[b].empty()) {
+            fine.depth_mm.push_back((b + 0.5) * BIN_MM);
+            fine.force_N.push_back(median(bins[b]));
+        }
+    }
+    TissueProfile t = thin(fine);
+
+    double pulled = 0.0, table = 0.0;
+    for (size_t r = 0; r < runs.size(); r++) {
+        for (size_t k = 0; k < runs[r].segments.size(); k++) {
+            for (const Sample& s : runs[r].segments[k]) {
+                double expected = t.force(s.mm + shifts[r][k] * BIN_MM);
+                if (!s.cutting && expected > 0.2) {
+                    pulled += s.force;
+                    table += expected;
+                }
+            }
+        }
+    }
+    if (table > 0.0) {
+        p->retract = fmin(1.0, pulled / table);
+    }
+    return t;
+}
+
+#pragma endregion
+
+#pragma region REPLAY
+
+struct ReplayError {
+    double rpm = 0.0;       ///< RMS output speed error.
+    double mA = 0.0;        ///< RMS current error.
+};
+
+/**
+ * @brief Drives the model with the logged PWM and force, starting every segment from the logged state.
+ *
+ */
+static ReplayError replay(const vector<Run>& runs, const NeedleParams& p) {
+    const double dt = 20e-6;
+    double rpm2 = 0.0, mA2 = 0.0;
+    size_t n = 0;
+    for (const Run& run : runs) {
+        for (const auto& seg : run.segments) {
+            NeedleModel m;
+            m.p = p;
+            const Sample& first = seg.front();
+            double d = first.pwm / MOTOR_ON;
+            double sign = first.cutting ? 1.0 : -1.0;
+            m.w = sign * motorRadS(p, first.rpm);
+            m.i = (d >= MIN_DUTY) ? sign * first.amps / d : 0.0;
+            bool dir = first.cutting ? MOTOR_FW : MOTOR_BW;
+            for (size_t k = 1; k < seg.size(); k++) {
+                const Sample& prev = seg[k - 1];
+                for (double t = prev.t; t < seg[k].t; t += dt) {
+                    m.step(dir, prev.pwm, dt, prev.force);
+                }
+                double e = fabs(m.outputRpm()) - seg[k].rpm;
+                double ei = (m.supplyAmps(seg[k].pwm) - seg[k].amps) * 1e3;
+                rpm2 += e * e;
+                mA2 += ei * ei;
+                n++;
+            }
+        }
+    }
+    ReplayError r;
+    if (n > 0) {
+        r.rpm = sqrt(rpm2 / n);
+        r.mA = sqrt(mA2 / n);
+    }
+    return r;
+}
+
+#pragma endregion
+
+#pragma region CHECK
+
+static const double PARAM_TOL = 0.1;    ///< --check: relative error allowed on each fitted parameter.
+static const double PEAK_TOL = 0.05;    ///< --check: relative error allowed on the puncture peak of the tissue table.
+static const double REPLAY_TOL = 0.1;   ///< --check: the fitted model may replay this much worse than the true one.
+
+static int failures = 0;
+
+static void check(bool ok, const char* what, double fitted, double expected) {
+    if (!ok) {
+        printf("FAIL: %s: fitted %.4g, simulated %.4g\n", what, fitted, expected);
+        failures++;
+    }
+}
+
+/**
+ * @brief --check: the runs are a host_sim --trace without --model and --tissue, so the fit has to come back with the
+ * default parameters and the standard tissue.
+ *
+ */
+static void checkRecovery(const NeedleParams& fitted, const TissueProfile& tissue, const ReplayError& truth,
+                          const ReplayError& fit) {
+    NeedleParams sim;
+    const struct {
+        const char* name;
+        double NeedleParams::*field;
+    } fields[] = {{"R", &NeedleParams::R}, {"ke", &NeedleParams::ke}, {"J", &NeedleParams::J},
+                  {"b", &NeedleParams::b}, {"tc", &NeedleParams::tc}, {"kf", &NeedleParams::kf},
+                  {"retract", &NeedleParams::retract}};
+    for (const auto& f : fields) {
+        check(fabs(fitted.*f.field - sim.*f.field) <= PARAM_TOL * sim.*f.field, f.name, fitted.*f.field, sim.*f.field);
+    }
+    TissueProfile standard = TissueProfile::standard();
+    double peak = tissue.force_N.empty() ? 0.0 : *max_element(tissue.force_N.begin(), tissue.force_N.end());
+    double simPeak = *max_element(standard.force_N.begin(), standard.force_N.end());
+    check(fabs(peak - simPeak) <= PEAK_TOL * simPeak, "tissue peak", peak, simPeak);
+    check(fit.rpm <= (1.0 + REPLAY_TOL) * truth.rpm, "replay RMS RPM", fit.rpm, truth.rpm);
+    check(fit.mA <= (1.0 + REPLAY_TOL) * truth.mA, "replay RMS mA", fit.mA, truth.mA);
+    printf("%s: %d failed checks\n", failures ? "FAIL" : "PASS", failures);
+}
+
+#pragma endregion
+
+static void usage() {
+    fprintf(stderr, "usage: model_fit [--volts V] [-o model.csv] [--tissue tissue.csv] [--check] dataN.csv...\n");
+}
+
+int main(int argc, char** argv) {
+    NeedleParams fitted;
+    string modelPath = "model.csv";
+    string tissuePath = "tissue.csv";
+    vector<string> inputs;
+    bool recovery = false;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--volts" && i + 1 < argc) {
+            fitted.volts = atof(argv[++i]);
+        } else if (arg == "-o" && i + 1 < argc) {
+            modelPath = argv[++i];
+        } else if (arg == "--tissue" && i + 1 < argc) {
+            tissuePath = argv[++i];
+        } else if (arg == "--check") {
+            recovery = true;
+        } else if (!arg.empty() && arg[0] != '-') {
+            inputs.push_back(arg);
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (inputs.empty() || fitted.volts <= 0.0) {
+        usage();
+        return 2;
+    }
+
+    vector<Run> runs;
+    size_t samples = 0;
+    for (const string& path : inputs) {
+        Run run;
+        if (!readRun(path, &run)) {
+            return 1;
+        }
+        for (const auto& seg : run.segments) {
+            samples += seg.size();
+        }
+        runs.push_back(run);
+    }
+    printf("%zu runs, %zu cutting/exiting samples at %.1f V\n", runs.size(), samples, fitted.volts);
+
+    NeedleParams defaults;
+    defaults.volts = fitted.volts;
+    if (!fitMotor(runs, &fitted)) {
+        return 1;
+    }
+    TissueProfile tissue = fitTissue(runs, &fitted);
+
+    printf("%-10s %12s %12s\n", "param", "default", "fitted");
+    const struct {
+        const char* name;
+        double NeedleParams::*field;
+    } shown[] = {{"R", &NeedleParams::R},   {"ke=kt", &NeedleParams::ke}, {"J", &NeedleParams::J},
+                 {"b", &NeedleParams::b},   {"tc", &NeedleParams::tc},    {"kf", &NeedleParams::kf},
+                 {"retract", &NeedleParams::retract}};
+    for (const auto& s : shown) {
+        printf("%-10s %12.4g %12.4g\n", s.name, defaults.*s.field, fitted.*s.field);
+    }
+    printf("tissue: %zu points, peak %.2f N\n", tissue.depth_mm.size(),
+           tissue.force_N.empty() ? 0.0 : *max_element(tissue.force_N.begin(), tissue.force_N.end()));
+
+    ReplayError before = replay(runs, defaults);
+    ReplayError after = replay(runs, fitted);
+    printf("replay RMS error: default %.2f RPM %.1f mA, fitted %.2f RPM %.1f mA\n", before.rpm, before.mA, after.rpm,
+           after.mA);
+
+    if (!needle_params_save(modelPath, fitted) || !tissue_save(tissuePath, tissue)) {
+        fprintf(stderr, "cannot write %s or %s\n", modelPath.c_str(), tissuePath.c_str());
+        return 1;
+    }
+    printf("wrote %s and %s\n", modelPath.c_str(), tissuePath.c_str());
+    if (recovery) {
+        checkRecovery(fitted, tissue, before, after);
+    }
+    return failures ? 1 : 0;
+}
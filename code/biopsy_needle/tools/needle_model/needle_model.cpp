@@ -0,0 +1,200 @@
+/**
+ * @file needle_model.cpp
+ * @author Thomas Chang
+ * @brief This file holds the definitions for the host physics model of the needle drive.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "needle_model.h"
+
+#include "config.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace std;
+
+double TissueProfile::force(double depth) const {
+    if (depth_mm.empty() || depth <= depth_mm.front() || depth >= depth_mm.back()) {
+        return 0.0;
+    }
+    size_t k = 1;
+    while (depth_mm[k] < depth) {
+        k++;
+    }
+    double f = (depth - depth_mm[k - 1]) / (depth_mm[k] - depth_mm[k - 1]);
+    return force_N[k - 1] + f * (force_N[k] - force_N[k - 1]);
+}
+
+TissueProfile TissueProfile::standard() {
+    TissueProfile t;
+    t.depth_mm = {1.0, 3.0, 3.4, 5.0, 21.0, 22.0};
+    t.force_N = {0.0, 6.0, 2.0, 3.0, 3.5, 0.0};
+    return t;
+}
+
+double NeedleModel::needleForce() const {
+    return last_force;
+}
+
+void NeedleModel::step(bool dir, double pwm, double dt, double force_N) {
+    // Winding current, exact for the speed at the start of the step.
+    double u = (dir == MOTOR_FW ? 1.0 : -1.0) * p.volts * pwm / MOTOR_ON;
+    double i_ss = (u - p.ke * w) / p.R;
+    if (dt != decay_dt || p.R != decay_R || p.L != decay_L) {
+        decay = exp(-p.R * dt / p.L);
+        decay_dt = dt;
+        decay_R = p.R;
+        decay_L = p.L;
+    }
+    double next = i_ss + (i - i_ss) * decay;
+    if (pwm == 0.0) {
+        // Driver off: the current decays through the diodes and does not reverse.
+        i = (next * i > 0.0) ? next : 0.0;
+    } else {
+        i = next;
+    }
+
+    // Tissue force opposes the motion; advancing sees the table, retracting a fraction of it.
+    double depth = depthMm();
+    double moving = (w != 0.0) ? w : p.kt * i;
+    double F = force_N;
+    if (F < 0.0) {
+        F = tissue_scale * tissue.force(depth) * (moving >= 0.0 ? 1.0 : p.retract);
+    }
+    last_force = (w == 0.0) ? 0.0 : (w > 0.0 ? F : -F);
+    double friction = p.tc + p.kf * F;
+
+    double torque = p.kt * i - p.b * w;
+    if (w != 0.0 || fabs(torque) > friction) {
+        double s = (w != 0.0) ? copysign(1.0, w) : copysign(1.0, torque);
+        double w_next = w + dt * (torque - s * friction) / p.J;
+        w = (w != 0.0 && w_next * w < 0.0) ? 0.0 : w_next;
+    }
+
+    double before = counts;
+    counts += w * dt / (2.0 * M_PI) * p.cpr;
+    if (counts > hi_wall || counts < lo_wall) {
+        counts = fmin(hi_wall, fmax(lo_wall, counts));
+        w = 0.0;
+    }
+
+    // Edges crossed in this step, at their interpolated times.
+    int32_t now = (int32_t)floor(counts);
+    while (count != now) {
+        int32_t edge = (now > count) ? count + 1 : count;
+        double frac = (counts != before) ? (edge - before) / (counts - before) : 1.0;
+        count += (now > count) ? 1 : -1;
+        edge_us = (uint64_t)llround((t + frac * dt) * 1e6);
+        if (edges) {
+            edges->push_back({count, edge_us});
+        }
+    }
+    t += dt;
+}
+
+double NeedleModel::supplyAmps(double pwm) const {
+    return fabs(i) * pwm / MOTOR_ON;
+}
+
+int16_t NeedleModel::ina219Raw(double pwm, double lsb_A, double noise_A) {
+    double raw = lround((supplyAmps(pwm) + noise(noise_A)) / lsb_A);
+    return (int16_t)fmax(-32768.0, fmin(32767.0, raw));
+}
+
+uint16_t NeedleModel::fx29Raw(double zero_counts, double n_per_count, double noise_counts) {
+    double raw = lround(zero_counts + last_force / n_per_count + noise(noise_counts));
+    return (uint16_t)fmax(0.0, fmin(16383.0, raw));
+}
+
+#pragma region FILES
+
+/// Fields of NeedleParams by name, for the CSV files.
+static const struct {
+    const char* name;
+    double NeedleParams::*field;
+} paramFields[] = {
+    {"R", &NeedleParams::R},           {"L", &NeedleParams::L},
+    {"kt", &NeedleParams::kt},         {"ke", &NeedleParams::ke},
+    {"J", &NeedleParams::J},           {"b", &NeedleParams::b},
+    {"tc", &NeedleParams::tc},         {"kf", &NeedleParams::kf},
+    {"gear", &NeedleParams::gear},     {"mm_per_rev", &NeedleParams::mm_per_rev},
+    {"cpr", &NeedleParams::cpr},       {"volts", &NeedleParams::volts},
+    {"retract", &NeedleParams::retract},
+};
+
+bool needle_params_load(const string& path, NeedleParams* p) {
+    FILE* in = fopen(path.c_str(), "r");
+    if (!in) {
+        return false;
+    }
+    char line[128];
+    while (fgets(line, sizeof(line), in)) {
+        char* comma = strchr(line, ',');
+        if (!comma) {
+            continue;
+        }
+        *comma = '\0';
+        for (const auto& f : paramFields) {
+            if (strcmp(line, f.name) == 0) {
+                p->*f.field = atof(comma + 1);
+            }
+        }
+    }
+    fclose(in);
+    return true;
+}
+
+bool needle_params_save(const string& path, const NeedleParams& p) {
+    FILE* out = fopen(path.c_str(), "w");
+    if (!out) {
+        return false;
+    }
+    fprintf(out, "name,value\n");
+    for (const auto& f : paramFields) {
+        fprintf(out, "%s,%.6g\n", f.name, p.*f.field);
+    }
+    return fclose(out) == 0;
+}
+
+bool tissue_load(const string& path, TissueProfile* t) {
+    FILE* in = fopen(path.c_str(), "r");
+    if (!in) {
+        return false;
+    }
+    TissueProfile loaded;
+    double d, f;
+    char line[128];
+    while (fgets(line, sizeof(line), in)) {
+        if (sscanf(line, "%lf,%lf", &d, &f) == 2) {
+            if (!loaded.depth_mm.empty() && d <= loaded.depth_mm.back()) {
+                fclose(in);
+                return false;
+            }
+            loaded.depth_mm.push_back(d);
+            loaded.force_N.push_back(f);
+        }
+    }
+    fclose(in);
+    *t = loaded;
+    return true;
+}
+
+bool tissue_save(const string& path, const TissueProfile& t) {
+    FILE* out = fopen(path.c_str(), "w");
+    if (!out) {
+        return false;
+    }
+    fprintf(out, "depth_mm,force_N\n");
+    for (size_t k = 0; k < t.depth_mm.size(); k++) {
+        fprintf(out, "%.3f,%.4f\n", t.depth_mm[k], t.force_N[k]);
+    }
+    return fclose(out) == 0;
+}
+
+#pragma endregion
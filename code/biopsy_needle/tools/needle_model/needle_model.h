@@ -0,0 +1,142 @@
+/**
+ * @file needle_model.h
+ * @author Thomas Chang
+ * @brief Host physics model of the needle drive: DC motor, gearbox, lead screw, friction and tissue.
+ * @details Shared by the host simulator (tools/host_sim) and the model fit (model_fit.cpp). The motor is
+ *
+ *     L di/dt = u - R i - ke w
+ *     J dw/dt = kt i - b w - sign(w) (tc + kf F)
+ *
+ * with u the bridge voltage (volts * pwm / MOTOR_ON, 0 and no current reversal while the PWM is 0), w the motor speed
+ * and F the force the tissue puts on the needle. The gearbox (gear) and the lead screw (mm_per_rev) turn motor
+ * revolutions into needle travel; kf folds both and their efficiency into motor torque per newton. Dry friction holds
+ * the motor at rest until the drive torque exceeds it. The current is integrated exactly for the step's speed, so the
+ * step can be tens of microseconds; encoder edges are interpolated inside the step and time stamped to the
+ * microsecond.
+ *
+ * The tissue is a table of force against depth for an advancing needle (TissueProfile); a retracting needle sees
+ * retract times that force. The INA219 sees the supply current of the bridge (winding current times duty) and the
+ * FX29 the needle force, compression positive.
+ *
+ * Parameters and tissue tables are read and written as "name,value" and "depth_mm,force_N" CSV files; model_fit writes
+ * them from recorded runs.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @brief Model constants. The defaults are the datasheet motor on a 2S pack; model_fit replaces them from logs.
+ *
+ */
+struct NeedleParams {
+    double R = 2.0;             ///< Winding resistance, ohm.
+    double L = 1e-3;            ///< Winding inductance, H. Too fast to see at the log rate; kept from the datasheet.
+    double kt = 7.4 / 712.0;    ///< Torque constant, Nm/A.
+    double ke = 7.4 / 712.0;    ///< Back EMF constant, V s/rad.
+    double J = 2e-6;            ///< Rotor and reflected inertia, kg m^2.
+    double b = 2e-6;            ///< Viscous friction, Nm s/rad.
+    double tc = 5e-4;           ///< Dry friction at the motor, Nm.
+    double kf = 2e-5;           ///< Motor torque per newton on the needle, Nm/N.
+    double gear = 34.014;       ///< Motor revolutions per output revolution (ENCODER_GEAR).
+    double mm_per_rev = 0.5;    ///< Needle travel per output revolution.
+    double cpr = 48;            ///< Encoder counts per motor revolution (ENCODER_CPR).
+    double volts = 7.4;         ///< Battery voltage.
+    double retract = 0.3;       ///< Tissue force while retracting, fraction of the force while advancing.
+};
+
+/**
+ * @brief One encoder edge.
+ *
+ */
+struct NeedleEdge {
+    int32_t count;      ///< Count after the edge.
+    uint64_t t_us;
+};
+
+/**
+ * @brief Force of the tissue against an advancing needle, piecewise linear in depth and 0 outside the table.
+ *
+ */
+struct TissueProfile {
+    std::vector<double> depth_mm;
+    std::vector<double> force_N;
+
+    double force(double depth) const;
+
+    /// Skin puncture at 3 mm, then steady cutting force through 20 mm of tissue.
+    static TissueProfile standard();
+};
+
+/**
+ * @brief The drive with its sensors. Counts are absolute; forward (MOTOR_FW) counts up.
+ *
+ */
+struct NeedleModel {
+    NeedleParams p;
+    TissueProfile tissue;
+    double tissue_scale = 1.0;      ///< Multiplies the tissue table, for harder or softer samples.
+    double lo_wall = -1e18;         ///< Hard stops in encoder counts (housing, obstacles).
+    double hi_wall = 1e18;
+
+    double i = 0.0;                 ///< Winding current, A.
+    double w = 0.0;                 ///< Motor speed, rad/s.
+    double counts = 0.0;            ///< Encoder position, continuous.
+    double t = 0.0;                 ///< Time, s.
+    int32_t count = 0;              ///< Encoder count, floor(counts).
+    uint64_t edge_us = 0;           ///< Time of the last edge.
+    std::vector<NeedleEdge>* edges = nullptr;  ///< Every edge is appended here if set.
+
+    std::mt19937 rng{1};
+
+    NeedleModel() : tissue(TissueProfile::standard()) {}
+
+    /**
+     * @brief Advances the model.
+     *
+     * @param dir MOTOR_FW or MOTOR_BW.
+     * @param pwm PWM level, 0 to MOTOR_ON.
+     * @param dt Step in seconds. Keep it well below the time between encoder edges.
+     * @param force_N Needle force to use instead of the tissue table, or a negative value to use the table.
+     */
+    void step(bool dir, double pwm, double dt, double force_N = -1.0);
+
+    /// Needle travel from count 0, mm.
+    double depthMm() const { return counts / (p.cpr * p.gear) * p.mm_per_rev; }
+    double outputRpm() const { return w * 60.0 / (2.0 * M_PI * p.gear); }
+    double stallTorque() const { return p.kt * p.volts / p.R; }
+
+    /// Force of the tissue on the needle now, compression positive.
+    double needleForce() const;
+
+    /// Current through the INA219 shunt on the supply side of the bridge, A.
+    double supplyAmps(double pwm) const;
+
+    /// INA219 current register: noise_A of white noise, quantised to lsb_A and clipped.
+    int16_t ina219Raw(double pwm, double lsb_A, double noise_A);
+
+    /// FX29 bridge data: noise_counts of white noise, 14 bit.
+    uint16_t fx29Raw(double zero_counts, double n_per_count, double noise_counts);
+
+    double noise(double sd) { return std::normal_distribution<double>(0.0, sd)(rng); }
+
+private:
+    double last_force = 0.0;
+    double decay = 0.0, decay_dt = 0.0, decay_R = 0.0, decay_L = 0.0;     ///< exp(-R dt / L) of the last step.
+};
+
+bool needle_params_load(const std::string& path, NeedleParams* p);
+bool needle_params_save(const std::string& path, const NeedleParams& p);
+bool tissue_load(const std::string& path, TissueProfile* t);
+bool tissue_save(const std::string& path, const TissueProfile& t);
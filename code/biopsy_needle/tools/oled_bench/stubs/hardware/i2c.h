@@ -0,0 +1,29 @@
+/**
+ * @file i2c.h
+ * @author Thomas Chang
+ * @brief Host stand-in for the Pico SDK I2C header. oled_bench.cpp implements the write into its display model.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include "pico/stdlib.h"
+
+#define PICO_ERROR_TIMEOUT  -1
+#define PICO_ERROR_GENERIC  -2
+
+typedef struct i2c_inst i2c_inst_t;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+int i2c_write_blocking(i2c_inst_t *i2c, uint8_t addr, const uint8_t *src, size_t len, bool nostop);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,12 @@
+/**
+ * @file binary_info.h
+ * @author Thomas Chang
+ * @brief Host stand-in for the Pico SDK header. Nothing in the display driver uses it.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
@@ -0,0 +1,18 @@
+/**
+ * @file stdlib.h
+ * @author Thomas Chang
+ * @brief Host stand-in for the Pico SDK header, with only what the SSD1306 and I2C DMA headers use.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#pragma once
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
@@ -0,0 +1,221 @@
+/**
+ * @file ring_test.cpp
+ * @author Thomas Chang
+ * @brief Host test and throughput benchmark for the SPSC ring that carries log records between the cores.
+ * @details Usage:
+ *
+ *     ring_test [--items N]
+ *
+ * Checks spsc_ring.h on one thread first: the empty and full states, the drop and high-water counters, and index
+ * wrap-around through pop() and through peek_span()/release(), where a span has to stop at the end of the storage.
+ * Then a producer and a consumer thread move --items 32-byte records, the size of a log record, through a 256 entry
+ * ring, once with pop() and once with peek_span(). The consumer checks that every record arrives once, in order and
+ * not torn. The throughput of each run is printed in million records per second. Exits with 1 if a check fails.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "spsc_ring.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+
+using namespace std;
+
+/**
+ * @brief Same size as a log record. Every word is derived from seq, so a torn copy is detected.
+ *
+ */
+struct Item {
+    uint32_t seq;
+    uint32_t words[7];
+};
+
+static Item makeItem(uint32_t seq) {
+    Item it;
+    it.seq = seq;
+    for (uint32_t k = 0; k < 7; k++) {
+        it.words[k] = seq * 2654435761u + k;
+    }
+    return it;
+}
+
+static bool intact(const Item& it) {
+    for (uint32_t k = 0; k < 7; k++) {
+        if (it.words[k] != it.seq * 2654435761u + k) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (!ok) {
+        printf("FAIL  %s\n", what);
+        failures++;
+    }
+}
+
+/**
+ * @brief Empty and full states, with the counters the logger reports at FINISH.
+ *
+ */
+static void testStates() {
+    static SpscRing<Item, 8> ring;
+    Item out;
+    const Item* span;
+
+    check(ring.size() == 0, "new ring is empty");
+    check(!ring.pop(out), "pop on an empty ring fails");
+    check(ring.peek_span(&span) == 0, "peek_span on an empty ring is 0");
+
+    for (uint32_t i = 0; i < 8; i++) {
+        check(ring.push(makeItem(i)), "push below capacity");
+    }
+    check(ring.size() == 8, "size at capacity");
+    check(!ring.push(makeItem(8)), "push on a full ring is dropped");
+    check(!ring.try_push(makeItem(8)), "try_push on a full ring fails");
+
+    ring_stats_t s = ring.stats();
+    check(s.pushed == 8 && s.popped == 0 && s.lag == 8, "stats when full");
+    check(s.dropped == 1, "push counts a drop, try_push does not");
+    check(s.high_water == 8, "high water at capacity");
+
+    for (uint32_t i = 0; i < 8; i++) {
+        check(ring.pop(out) && out.seq == i && intact(out), "pop returns items in order");
+    }
+    check(!ring.pop(out), "pop after draining fails");
+    check(ring.size() == 0, "drained ring is empty");
+
+    ring.reset_stats();
+    s = ring.stats();
+    check(s.dropped == 0 && s.high_water == 0, "reset_stats clears drops and high water");
+}
+
+/**
+ * @brief Runs the head and tail many times around the storage, with every fill level at the seam.
+ *
+ */
+static void testWrap() {
+    static SpscRing<Item, 8> ring;
+    uint32_t next = 0, expect = 0;
+    Item out;
+
+    for (int lap = 0; lap < 1000; lap++) {
+        uint32_t fill = 1 + lap % 8;
+        for (uint32_t i = 0; i < fill; i++) {
+            check(ring.push(makeItem(next++)), "push during wrap");
+        }
+        for (uint32_t i = 0; i < fill; i++) {
+            check(ring.pop(out) && out.seq == expect++ && intact(out), "pop order during wrap");
+        }
+    }
+    check(ring.stats().dropped == 0, "no drops during wrap");
+
+    // Spans stop at the end of the storage; the rest comes on the next call.
+    static SpscRing<Item, 8> spans;
+    next = expect = 0;
+    for (int lap = 0; lap < 1000; lap++) {
+        uint32_t fill = 1 + (lap * 3) % 8;
+        for (uint32_t i = 0; i < fill; i++) {
+            spans.push(makeItem(next++));
+        }
+        uint32_t got = 0;
+        const Item* span;
+        uint32_t n;
+        while ((n = spans.peek_span(&span)) > 0) {
+            check(n <= fill - got, "span is not longer than what is queued");
+            for (uint32_t i = 0; i < n; i++) {
+                check(span[i].seq == expect++ && intact(span[i]), "span order during wrap");
+            }
+            got += n;
+            spans.release(n);
+        }
+        check(got == fill, "spans cover everything queued");
+    }
+    check(spans.size() == 0, "span drain leaves the ring empty");
+}
+
+/**
+ * @brief One producer and one consumer thread, like core 0 and core 1.
+ *
+ * @param items Records to move.
+ * @param bulk Drain with peek_span()/release() instead of pop().
+ * @return double Million records per second.
+ */
+static double runThreads(uint32_t items, bool bulk) {
+    static SpscRing<Item, 256> ring;
+    bool inOrder = true;
+
+    auto t0 = chrono::steady_clock::now();
+    thread consumer([&] {
+        uint32_t expect = 0;
+        while (expect < items) {
+            if (bulk) {
+                const Item* span;
+                uint32_t n = ring.peek_span(&span);
+                if (n == 0) {
+                    this_thread::yield();
+                }
+                for (uint32_t i = 0; i < n; i++) {
+                    if (span[i].seq != expect++ || !intact(span[i])) {
+                        inOrder = false;
+                    }
+                }
+                ring.release(n);
+            } else {
+                Item out;
+                if (!ring.pop(out)) {
+                    this_thread::yield();
+                } else if (out.seq != expect++ || !intact(out)) {
+                    inOrder = false;
+                }
+            }
+        }
+    });
+    for (uint32_t i = 0; i < items; i++) {
+        Item it = makeItem(i);
+        while (!ring.try_push(it)) {
+            this_thread::yield();   // lets the consumer run when both threads share a core
+        }
+    }
+    consumer.join();
+    double s = chrono::duration<double>(chrono::steady_clock::now() - t0).count();
+
+    check(inOrder, bulk ? "two threads, peek_span: every record once, in order, intact"
+                        : "two threads, pop: every record once, in order, intact");
+    check(ring.size() == 0, "two threads: ring empty at the end");
+    return items / s / 1e6;
+}
+
+int main(int argc, char** argv) {
+    uint32_t items = 4000000;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--items" && i + 1 < argc) {
+            items = (uint32_t)strtoul(argv[++i], nullptr, 10);
+        } else {
+            fprintf(stderr, "usage: ring_test [--items N]\n");
+            return 2;
+        }
+    }
+
+    testStates();
+    testWrap();
+    double popRate = runThreads(items, false);
+    double spanRate = runThreads(items, true);
+
+    printf("%u records of %u bytes through a %u entry ring, two threads\n", items, (unsigned)sizeof(Item), 256u);
+    printf("  pop()        %7.1f M records/s\n", popRate);
+    printf("  peek_span()  %7.1f M records/s\n", spanRate);
+    printf("%s\n", failures ? "FAILED" : "all checks passed");
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,381 @@
+/**
+ * @file runlog_convert.cpp
+ * @author Thomas Chang
+ * @brief Host tool that converts binary run logs (dataN.bin) written by the device.
+ * @details Usage:
+ *
+ *     runlog_convert [--info] [-o out.csv] [--columns DIR] dataN.bin
+ *
+ * Without options the log is written as dataN.csv next to the input, in the same layout the firmware used to write
+ * (state name, time in ms, then every data channel). --columns writes one little-endian float64 file per channel plus
+ * schema.csv and params.csv, which numpy/MATLAB can load without parsing text. --info prints the header and exits.
+ *
+ * Everything needed to decode a record comes from the channel table in the file, so adding a channel to the firmware
+ * does not require changes here.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#include "runlog_format.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+struct RunLog {
+    runlog_header_t header;
+    vector<runlog_channel_t> channels;
+    vector<runlog_param_t> params;
+    vector<uint8_t> records;    ///< Record area, trimmed to whole records.
+    size_t count = 0;           ///< Number of records.
+};
+
+/**
+ * @brief Reads a little-endian value of the given type and applies the channel scale.
+ *
+ * @param rec Start of the record.
+ * @param ch Channel to read.
+ * @param out Physical value.
+ * @return false if the channel type is unknown to this version of the tool.
+ */
+static bool readChannel(const uint8_t* rec, const runlog_channel_t& ch, double* out) {
+    const uint8_t* p = rec + ch.offset;
+    switch (ch.type) {
+        case RUNLOG_U8:  { *out = p[0]; break; }
+        case RUNLOG_U16: { uint16_t v; memcpy(&v, p, 2); *out = v; break; }
+        case RUNLOG_U32: { uint32_t v; memcpy(&v, p, 4); *out = v; break; }
+        case RUNLOG_I16: { int16_t v;  memcpy(&v, p, 2); *out = v; break; }
+        case RUNLOG_I32: { int32_t v;  memcpy(&v, p, 4); *out = v; break; }
+        case RUNLOG_F32: { float v;    memcpy(&v, p, 4); *out = v; break; }
+        default: return false;
+    }
+    *out *= ch.scale;
+    return true;
+}
+
+static size_t typeSize(uint8_t type) {
+    switch (type) {
+        case RUNLOG_U8:  return 1;
+        case RUNLOG_U16: case RUNLOG_I16: return 2;
+        case RUNLOG_U32: case RUNLOG_I32: case RUNLOG_F32: return 4;
+        default: return 0;
+    }
+}
+
+/**
+ * @brief Loads and validates a run log.
+ *
+ * @param path Input file.
+ * @param log Filled on success.
+ * @return false with a message on stderr if the file is not a readable run log.
+ */
+static bool load(const string& path, RunLog& log) {
+    ifstream in(path, ios::binary);
+    if (!in) {
+        fprintf(stderr, "%s: cannot open\n", path.c_str());
+        return false;
+    }
+    vector<uint8_t> data((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+
+    if (data.size() < sizeof(runlog_header_t)) {
+        fprintf(stderr, "%s: too short for a run log header\n", path.c_str());
+        return false;
+    }
+    memcpy(&log.header, data.data(), sizeof(runlog_header_t));
+    const runlog_header_t& h = log.header;
+    if (memcmp(h.magic, RUNLOG_MAGIC, sizeof(RUNLOG_MAGIC)) != 0) {
+        fprintf(stderr, "%s: not a run log\n", path.c_str());
+        return false;
+    }
+    if (h.version > RUNLOG_VERSION) {
+        fprintf(stderr, "%s: format version %u is newer than this tool (%d)\n", path.c_str(), h.version, RUNLOG_VERSION);
+        return false;
+    }
+
+    size_t tables = sizeof(runlog_header_t) + h.channel_count * sizeof(runlog_channel_t) + h.param_count * sizeof(runlog_param_t);
+    if (h.record_size == 0 || tables > h.header_size || h.header_size > data.size()) {
+        fprintf(stderr, "%s: corrupt header\n", path.c_str());
+        return false;
+    }
+
+    const uint8_t* p = data.data() + sizeof(runlog_header_t);
+    log.channels.resize(h.channel_count);
+    memcpy(log.channels.data(), p, h.channel_count * sizeof(runlog_channel_t));
+    p += h.channel_count * sizeof(runlog_channel_t);
+    log.params.resize(h.param_count);
+    memcpy(log.params.data(), p, h.param_count * sizeof(runlog_param_t));
+
+    for (const runlog_channel_t& ch : log.channels) {
+        size_t sz = typeSize(ch.type);
+        if (sz != 0 && ch.offset + sz > h.record_size) {
+            fprintf(stderr, "%s: channel %.16s lies outside the record\n", path.c_str(), ch.name);
+            return false;
+        }
+    }
+
+    size_t body = data.size() - h.header_size;
+    log.count = body / h.record_size;
+    if (body % h.record_size != 0) {
+        // A run cut short by power loss can end in a partial record.
+        fprintf(stderr, "%s: ignoring %zu trailing bytes\n", path.c_str(), body % h.record_size);
+    }
+    log.records.assign(data.begin() + h.header_size, data.begin() + h.header_size + log.count * h.record_size);
+    return true;
+}
+
+static string field(const char* s, size_t len) {
+    return string(s, strnlen(s, len));
+}
+
+static string stateName(const runlog_header_t& h, double v) {
+    unsigned idx = (unsigned)v;
+    if (idx < RUNLOG_MAX_STATES && h.state_names[idx][0] != '\0') {
+        return field(h.state_names[idx], RUNLOG_STATE_LEN);
+    }
+    return to_string(idx);
+}
+
+/**
+ * @brief Rebuilds the 64 bit time base from the wrapping 32 bit microsecond timestamps.
+ *
+ * @param out Microseconds since boot, monotonic across wraps.
+ * @return false if the channel cannot be read.
+ */
+static bool unwrapTime(const RunLog& log, const runlog_channel_t& ch, vector<double>* out) {
+    out->assign(log.count, 0.0);
+    uint64_t t = 0;
+    uint32_t prev = 0;
+    for (size_t i = 0; i < log.count; i++) {
+        double raw;
+        if (!readChannel(&log.records[i * log.header.record_size], ch, &raw)) {
+            return false;
+        }
+        uint32_t now = (uint32_t)raw;
+        t = (i == 0) ? now : t + (uint32_t)(now - prev);
+        prev = now;
+        (*out)[i] = (double)t;
+    }
+    return true;
+}
+
+static void printInfo(const RunLog& log) {
+    const runlog_header_t& h = log.header;
+    printf("format version : %u\n", h.version);
+    printf("firmware       : %s\n", field(h.firmware_rev, RUNLOG_REV_LEN).c_str());
+    printf("run number     : %u\n", h.run_number);
+    printf("sample rate    : %u Hz\n", h.sample_rate_hz);
+    printf("records        : %zu x %u bytes\n", log.count, h.record_size);
+    printf("channels       :\n");
+    for (const runlog_channel_t& ch : log.channels) {
+        printf("  %-16s %-8s type %u offset %2u role %u scale %g\n", field(ch.name, RUNLOG_NAME_LEN).c_str(),
+               field(ch.unit, RUNLOG_UNIT_LEN).c_str(), ch.type, ch.offset, ch.role, ch.scale);
+    }
+    printf("parameters     :\n");
+    for (const runlog_param_t& p : log.params) {
+        printf("  %-16s %g\n", field(p.name, RUNLOG_NAME_LEN).c_str(), p.value);
+    }
+}
+
+/**
+ * @brief Writes the log in the CSV layout the firmware produced before the binary format.
+ *
+ */
+static bool writeCsv(const RunLog& log, const string& path) {
+    FILE* out = fopen(path.c_str(), "w");
+    if (!out) {
+        fprintf(stderr, "%s: cannot create\n", path.c_str());
+        return false;
+    }
+
+    const runlog_channel_t* stateCh = nullptr;
+    const runlog_channel_t* timeCh = nullptr;
+    vector<const runlog_channel_t*> dataCh;
+    for (const runlog_channel_t& ch : log.channels) {
+        if (typeSize(ch.type) == 0) {
+            continue;
+        }
+        if (ch.role == RUNLOG_ROLE_STATE && !stateCh) {
+            stateCh = &ch;
+        } else if (ch.role == RUNLOG_ROLE_TIME_US && !timeCh) {
+            timeCh = &ch;
+        } else if (ch.role == RUNLOG_ROLE_DATA) {
+            dataCh.push_back(&ch);
+        }
+    }
+
+    string header;
+    if (stateCh) header += "State, ";
+    if (timeCh) header += "Time(ms), ";
+    for (const runlog_channel_t* ch : dataCh) {
+        string unit = field(ch->unit, RUNLOG_UNIT_LEN);
+        header += field(ch->name, RUNLOG_NAME_LEN) + (unit.empty() ? "" : "(" + unit + ")") + ", ";
+    }
+    header.resize(header.size() - 2);
+    fprintf(out, "%s\n", header.c_str());
+
+    vector<double> time;
+    if (timeCh && !unwrapTime(log, *timeCh, &time)) {
+        fprintf(stderr, "%s: cannot read channel %.16s\n", path.c_str(), timeCh->name);
+        fclose(out);
+        return false;
+    }
+    for (size_t i = 0; i < log.count; i++) {
+        const uint8_t* rec = &log.records[i * log.header.record_size];
+        const char* sep = "";
+        double v;
+        if (stateCh) {
+            if (!readChannel(rec, *stateCh, &v)) {
+                fprintf(stderr, "%s: cannot read channel %.16s\n", path.c_str(), stateCh->name);
+                fclose(out);
+                return false;
+            }
+            fprintf(out, "%s", stateName(log.header, v).c_str());
+            sep = ",";
+        }
+        if (timeCh) {
+            fprintf(out, "%s%llu", sep, (unsigned long long)(time[i] / 1000));
+            sep = ",";
+        }
+        for (const runlog_channel_t* ch : dataCh) {
+            if (!readChannel(rec, *ch, &v)) {
+                fprintf(stderr, "%s: cannot read channel %.16s\n", path.c_str(), ch->name);
+                fclose(out);
+                return false;
+            }
+            fprintf(out, "%s%f", sep, v);
+            sep = ",";
+        }
+        fprintf(out, "\n");
+    }
+    fclose(out);
+    return true;
+}
+
+/**
+ * @brief Writes one float64 column file per channel plus schema.csv and params.csv into dir.
+ * @details Times are unwrapped microseconds; states are their numeric value (names are listed in schema.csv).
+ */
+static bool writeColumns(const RunLog& log, const string& dir) {
+    error_code ec;
+    filesystem::create_directories(dir, ec);
+    if (ec) {
+        fprintf(stderr, "%s: %s\n", dir.c_str(), ec.message().c_str());
+        return false;
+    }
+
+    FILE* schema = fopen((dir + "/schema.csv").c_str(), "w");
+    if (!schema) {
+        fprintf(stderr, "%s: cannot create schema.csv\n", dir.c_str());
+        return false;
+    }
+    fprintf(schema, "column,unit,role,dtype,count,file\n");
+
+    for (const runlog_channel_t& ch : log.channels) {
+        if (typeSize(ch.type) == 0) {
+            continue;
+        }
+        string name = field(ch.name, RUNLOG_NAME_LEN);
+        string file = name + ".f64";
+
+        vector<double> col(log.count);
+        bool ok = true;
+        if (ch.role == RUNLOG_ROLE_TIME_US) {
+            ok = unwrapTime(log, ch, &col);
+        } else {
+            for (size_t i = 0; i < log.count && ok; i++) {
+                ok = readChannel(&log.records[i * log.header.record_size], ch, &col[i]);
+            }
+        }
+        if (!ok) {
+            fprintf(stderr, "%s: cannot read channel %s\n", dir.c_str(), name.c_str());
+            fclose(schema);
+            return false;
+        }
+
+        ofstream out(dir + "/" + file, ios::binary);
+        out.write(reinterpret_cast<const char*>(col.data()), col.size() * sizeof(double));
+        fprintf(schema, "%s,%s,%u,float64,%zu,%s\n", name.c_str(), field(ch.unit, RUNLOG_UNIT_LEN).c_str(), ch.role,
+                log.count, file.c_str());
+    }
+    fclose(schema);
+
+    FILE* params = fopen((dir + "/params.csv").c_str(), "w");
+    if (!params) {
+        fprintf(stderr, "%s: cannot create params.csv\n", dir.c_str());
+        return false;
+    }
+    fprintf(params, "name,value\n");
+    fprintf(params, "firmware_rev,%s\n", field(log.header.firmware_rev, RUNLOG_REV_LEN).c_str());
+    fprintf(params, "run_number,%u\n", log.header.run_number);
+    fprintf(params, "sample_rate_hz,%u\n", log.header.sample_rate_hz);
+    for (unsigned i = 0; i < RUNLOG_MAX_STATES; i++) {
+        if (log.header.state_names[i][0] != '\0') {
+            fprintf(params, "state_%u,%s\n", i, field(log.header.state_names[i], RUNLOG_STATE_LEN).c_str());
+        }
+    }
+    for (const runlog_param_t& p : log.params) {
+        fprintf(params, "%s,%g\n", field(p.name, RUNLOG_NAME_LEN).c_str(), p.value);
+    }
+    fclose(params);
+    return true;
+}
+
+static void usage() {
+    fprintf(stderr, "usage: runlog_convert [--info] [-o out.csv] [--columns DIR] dataN.bin\n");
+}
+
+int main(int argc, char** argv) {
+    string input, csvPath, columnsDir;
+    bool info = false;
+
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--info") {
+            info = true;
+        } else if (arg == "-o" && i + 1 < argc) {
+            csvPath = argv[++i];
+        } else if (arg == "--columns" && i + 1 < argc) {
+            columnsDir = argv[++i];
+        } else if (!arg.empty() && arg[0] != '-' && input.empty()) {
+            input = arg;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (input.empty()) {
+        usage();
+        return 2;
+    }
+
+    RunLog log;
+    if (!load(input, log)) {
+        return 1;
+    }
+    if (info) {
+        printInfo(log);
+        return 0;
+    }
+
+    if (!columnsDir.empty()) {
+        if (!writeColumns(log, columnsDir)) {
+            return 1;
+        }
+        if (csvPath.empty()) {
+            return 0;
+        }
+    }
+
+    if (csvPath.empty()) {
+        csvPath = filesystem::path(input).replace_extension(".csv").string();
+    }
+    return writeCsv(log, csvPath) ? 0 : 1;
+}
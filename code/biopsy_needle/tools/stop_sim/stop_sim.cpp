@@ -0,0 +1,220 @@
+/**
+ * @file stop_sim.cpp
+ * @author Thomas Chang
+ * @brief Host simulation of the end of a cut: how far past fwRev the needle comes to rest.
+ * @details Usage:
+ *
+ *     stop_sim [--runs N] [--volts V] [--load FRAC] [--brake]
+ *
+ * A DC motor and gearbox model is driven through the firmware's own motion profile (motion_profile.cpp) and
+ * predictive stop (stop_predict.cpp), with the config.h settings, toward fwRev. The control loop runs at
+ * SPEED_CTRL_HZ on a quantised encoder position; a PI loop with the config.h gains stands in for speed_control.cpp.
+ * Every case is run twice:
+ *
+ *  - task:    the old check. The control task notices the limit on its next tick, up to a tick after the sample,
+ *             and the PWM goes off on the following loop tick.
+ *  - predict: the loop cuts the PWM itself when stop_update() says the needle would coast onto the limit.
+ *
+ * Each case is repeated --runs times with the learned coast time carried over, like consecutive cuts on the device,
+ * and the landing error of every run is reported in micrometres (positive past the limit). --load is the tissue drag as
+ * a fraction of the stall torque. --brake models a driver that shorts the motor when the PWM is 0 instead of letting it
+ * coast.
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2025
+ *
+ */
+
+#define MOTOR_ON 255
+
+#include "config.h"
+#include "motion_profile.h"
+#include "stop_predict.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const double COUNTS_PER_REV = ENCODER_CPR * (double)ENCODER_GEAR;
+static const double UM_PER_COUNT = 500.0 / COUNTS_PER_REV;     ///< 0.5 mm of travel per output revolution.
+static const double TICK_S = 1.0 / SPEED_CTRL_HZ;
+static const int SUBSTEPS = 100;
+
+struct Options {
+    int runs = 5;
+    double volts = 7.4;
+    double load = 0.25;
+    bool brake = false;
+};
+
+/**
+ * @brief Brushed motor behind the gearbox: armature circuit, rotor inertia, viscous and tissue friction.
+ *
+ */
+struct Motor {
+    double R = 2.0, L = 1e-3, ke = 7.4 / 712.0, J = 2e-6, b = 2e-6;
+    double volts, drag;
+    bool brake;
+    double i = 0.0, w = 0.0, counts = 0.0;    ///< Current, motor rad/s, encoder counts (continuous).
+    double edge_t = 0.0;                        ///< Time of the last encoder edge.
+
+    Motor(const Options& o) : volts(o.volts), drag(o.load * ke * o.volts / 2.0), brake(o.brake) {}
+
+    void step(double pwm, double t, double dt) {
+        double u = volts * pwm / MOTOR_ON;
+        bool off = (pwm == 0.0);
+        if (off && !brake) {
+            // Coasting: the driver is high impedance, the winding current decays through the diodes.
+            i = fmax(0.0, i + dt * (-R * i - ke * w) / L);
+        } else {
+            i += dt * (u - R * i - ke * w) / L;
+        }
+        double torque = ke * i - b * w - (w > 0.0 ? drag : 0.0);
+        w = fmax(0.0, w + dt * torque / J);
+        double before = floor(counts);
+        counts += w * dt / (2.0 * M_PI) * ENCODER_CPR;
+        if (floor(counts) != before) {
+            edge_t = t + dt;
+        }
+    }
+};
+
+/**
+ * @brief Speed as the firmware measures it (M/T): counts between the last edges of two samples over the time between
+ * those edges, 0 after ENCODER_ZERO_US without one.
+ *
+ */
+struct Encoder {
+    int32_t last = 0;
+    double edge_t = 0.0, cps = 0.0;
+
+    void sample(const Motor& m, double t) {
+        int32_t c = (int32_t)floor(m.counts);
+        if (c != last) {
+            if (m.edge_t > edge_t) {
+                cps = (c - last) / (m.edge_t - edge_t);
+            }
+            edge_t = m.edge_t;
+            last = c;
+        } else if (t - edge_t > ENCODER_ZERO_US * 1e-6) {
+            cps = 0.0;
+        }
+    }
+};
+
+/**
+ * @brief Runs one cut from 0 to fwRev and returns the landing error in counts.
+ *
+ */
+static double cut(const Options& o, bool predict, double rpm, bool useProfile, stop_predictor_t* sp) {
+    const int fwRev = 50;
+    const int32_t limit = (int32_t)lround(fwRev * COUNTS_PER_REV);
+    Motor m(o);
+    Encoder enc;
+    motion_profile_t prof;
+    const motion_profile_config_t pcfg = {PROFILE_ACCEL, PROFILE_JERK, PROFILE_MIN_RPM, PROFILE_TOL_REV};
+    motion_profile_init(&prof, &pcfg);
+    motion_profile_start(&prof, 0.0f, (float)fwRev, (float)rpm);
+    stop_arm(sp, 0, limit);
+
+    double pwm = 0.0, integ = 0.0, t = 0.0;
+    bool stopped = false;
+    int stopAtTick = -1;
+    for (int tick = 0; tick < 200 * SPEED_CTRL_HZ; tick++) {
+        enc.sample(m, t);
+        double cps = enc.cps;
+        int32_t pos = enc.last;
+        float target = useProfile ? motion_profile_update(&prof, (float)(pos / COUNTS_PER_REV), (float)TICK_S) : (float)rpm;
+
+        if (predict) {
+            stopped = stop_update(sp, pos, (float)cps, (float)TICK_S, 20e-6f);
+        } else if (!stopped) {
+            if (stopAtTick < 0 && (pos > limit || (useProfile && motion_profile_done(&prof)))) {
+                // Seen by the control task somewhere in the next tick, applied by the loop on the tick after.
+                stopAtTick = tick + 1 + (rand() % 2);
+            }
+            stopped = (stopAtTick >= 0 && tick >= stopAtTick);
+        }
+        if (stopped || target <= 0.0f) {
+            pwm = 0.0;
+            integ = 0.0;
+        } else {
+            double meas = cps * 60.0 / COUNTS_PER_REV;
+            double e = target - meas;
+            integ = fmax(-MOTOR_ON, fmin(MOTOR_ON, integ + SPEED_KI * e * TICK_S));
+            double want = SPEED_KFF * target + SPEED_FF0 + SPEED_KP * e + integ;
+            double step = SPEED_SLEW * TICK_S;
+            pwm = fmax(0.0, fmin((double)MOTOR_ON, fmax(pwm - step, fmin(pwm + step, want))));
+        }
+
+        for (int k = 0; k < SUBSTEPS; k++) {
+            m.step(pwm, t + k * TICK_S / SUBSTEPS, TICK_S / SUBSTEPS);
+        }
+        t += TICK_S;
+        if (stopped && m.w == 0.0 && (!predict || sp->settled)) {
+            break;
+        }
+    }
+    return m.counts - limit;
+}
+
+static void usage() {
+    fprintf(stderr, "usage: stop_sim [--runs N] [--volts V] [--load FRAC] [--brake]\n");
+}
+
+int main(int argc, char** argv) {
+    Options o;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--runs" && i + 1 < argc) {
+            o.runs = atoi(argv[++i]);
+        } else if (arg == "--volts" && i + 1 < argc) {
+            o.volts = atof(argv[++i]);
+        } else if (arg == "--load" && i + 1 < argc) {
+            o.load = atof(argv[++i]);
+        } else if (arg == "--brake") {
+            o.brake = true;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (o.runs < 1) {
+        usage();
+        return 2;
+    }
+
+    const stop_config_t scfg = {STOP_COAST_S, STOP_COAST_MIN, STOP_COAST_MAX, STOP_LEARN};
+    printf("%.1f V, load %.2f, %s, %d runs each; landing error in um (positive past fwRev)\n", o.volts, o.load,
+           o.brake ? "brake" : "coast", o.runs);
+    printf("%-8s %5s  %-8s %10s %10s  %s\n", "profile", "RPM", "stop", "mean |e|", "max |e|", "runs");
+    for (int useProfile = 0; useProfile < 2; useProfile++) {
+        for (double rpm : {30.0, 60.0, 100.0, 150.0}) {
+            for (int predict = 0; predict < 2; predict++) {
+                stop_predictor_t sp;
+                stop_init(&sp, &scfg);
+                srand(1);
+                vector<double> err;
+                double sum = 0.0, worst = 0.0;
+                for (int r = 0; r < o.runs; r++) {
+                    double e = cut(o, predict, rpm, useProfile, &sp) * UM_PER_COUNT;
+                    err.push_back(e);
+                    sum += fabs(e);
+                    worst = fmax(worst, fabs(e));
+                }
+                printf("%-8s %5.0f  %-8s %10.1f %10.1f  ", useProfile ? "s-curve" : "none", rpm,
+                       predict ? "predict" : "task", sum / o.runs, worst);
+                for (double e : err) {
+                    printf(" %+.0f", e);
+                }
+                printf("\n");
+            }
+        }
+    }
+    return 0;
+}